@@ -0,0 +1,158 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <utility>
+
+#if defined(__linux__)
+#  include <linux/perf_event.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+/// @file
+/// @brief Minimal runtime benchmark harness for ctql_bench.
+/// @details
+/// `run(name, ops, fn)` times `fn()` over a few repetitions and prints the median
+/// repetition per operation: nanoseconds, and on Linux CPU cycles and cache misses
+/// from `perf_event_open`. Counters read as `-` when the kernel refuses them
+/// (e.g. `perf_event_paranoid`, containers, no PMU).
+
+namespace ctql_bench {
+
+    /// @brief Keep @p v alive, so the optimizer cannot drop the work producing it.
+    template <typename T>
+    inline void keep(const T& v) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(v) : "memory");
+#else
+        static const void* volatile sink;
+        sink = &v;
+#endif
+    }
+
+    struct sample {
+        double ns           = 0;
+        std::uint64_t cycles = 0;
+        std::uint64_t misses = 0;
+    };
+
+    /// @brief Hardware cycle and cache-miss counters of the calling thread, as one group.
+    class perf_counters {
+    public:
+        perf_counters() {
+#if defined(__linux__)
+            leader_ = open(PERF_COUNT_HW_CPU_CYCLES, -1);
+            if (leader_ >= 0)
+                member_ = open(PERF_COUNT_HW_CACHE_MISSES, leader_);
+#endif
+        }
+
+        perf_counters(const perf_counters&)            = delete;
+        perf_counters& operator=(const perf_counters&) = delete;
+
+        ~perf_counters() {
+#if defined(__linux__)
+            if (member_ >= 0)
+                ::close(member_);
+            if (leader_ >= 0)
+                ::close(leader_);
+#endif
+        }
+
+        bool has_cycles() const noexcept { return leader_ >= 0; }
+        bool has_misses() const noexcept { return member_ >= 0; }
+
+        void start() noexcept {
+#if defined(__linux__)
+            if (leader_ >= 0) {
+                ::ioctl(leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+                ::ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+            }
+#endif
+        }
+
+        /// @brief Stop counting; fills `cycles` and `misses` of @p s.
+        void stop(sample& s) noexcept {
+#if defined(__linux__)
+            if (leader_ < 0)
+                return;
+            ::ioctl(leader_, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+            struct {
+                std::uint64_t nr;
+                std::uint64_t values[2];
+            } group{};
+            if (::read(leader_, &group, sizeof group) > 0) {
+                s.cycles = group.values[0];
+                s.misses = group.nr > 1 ? group.values[1] : 0;
+            }
+#else
+            (void)s;
+#endif
+        }
+
+    private:
+#if defined(__linux__)
+        static int open(std::uint64_t config, int group) noexcept {
+            perf_event_attr attr{};
+            attr.type           = PERF_TYPE_HARDWARE;
+            attr.size           = sizeof attr;
+            attr.config         = config;
+            attr.disabled       = group == -1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv     = 1;
+            attr.read_format    = PERF_FORMAT_GROUP;
+            return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, group, 0));
+        }
+#endif
+
+        int leader_ = -1;
+        int member_ = -1;
+    };
+
+    inline perf_counters& counters() {
+        static perf_counters c;
+        return c;
+    }
+
+    /// @brief Print a section heading.
+    inline void section(const char* title) { std::printf("\n## %s\n\n", title); }
+
+    /**
+     * @brief Time @p fn, which performs @p ops operations per call, and print one row.
+     * @details One warm-up call, then `Reps` timed calls; the median call is reported.
+     */
+    template <std::size_t Reps = 7, typename Fn>
+    sample run(const char* name, std::size_t ops, Fn&& fn) {
+        fn();
+        std::array<sample, Reps> reps{};
+        for (sample& s : reps) {
+            counters().start();
+            const auto t0 = std::chrono::steady_clock::now();
+            fn();
+            const auto t1 = std::chrono::steady_clock::now();
+            counters().stop(s);
+            s.ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        }
+        std::sort(reps.begin(), reps.end(), [](const sample& a, const sample& b) { return a.ns < b.ns; });
+        const sample& m = reps[Reps / 2];
+        const double n  = static_cast<double>(ops);
+
+        std::printf("%-44s %9.2f ns/op", name, m.ns / n);
+        if (counters().has_cycles())
+            std::printf(" %9.2f cyc/op", static_cast<double>(m.cycles) / n);
+        else
+            std::printf(" %9s cyc/op", "-");
+        if (counters().has_misses())
+            std::printf(" %9.4f miss/op\n", static_cast<double>(m.misses) / n);
+        else
+            std::printf(" %9s miss/op\n", "-");
+        return m;
+    }
+
+} // namespace ctql_bench
@@ -0,0 +1,49 @@
+#!/usr/bin/env sh
+# Include cost of each ctql header: front-end time of a TU that only includes it.
+#
+#   bench/include_cost.sh [runs]        (default: 5 runs, median reported)
+#
+# Environment: CXX (default c++), CXXFLAGS (default -std=c++23 -O0).
+# The "empty" row is the fixed cost of starting the compiler; subtract it to get
+# what a header itself costs.
+
+set -eu
+
+root=$(cd "$(dirname "$0")/.." && pwd)
+runs=${1:-5}
+cxx=${CXX:-c++}
+flags=${CXXFLAGS:--std=c++23 -O0}
+tmp=$(mktemp -d)
+trap 'rm -rf "$tmp"' EXIT
+
+# Median wall time in ms of compiling "$tmp/tu.cpp" $runs times.
+measure() {
+    i=0
+    : > "$tmp/times"
+    while [ "$i" -lt "$runs" ]; do
+        start=$(date +%s%N)
+        # shellcheck disable=SC2086
+        $cxx $flags -I"$root" -I"$root/include" -fsyntax-only "$tmp/tu.cpp"
+        end=$(date +%s%N)
+        echo $(((end - start) / 1000000)) >> "$tmp/times"
+        i=$((i + 1))
+    done
+    sort -n "$tmp/times" | sed -n "$(((runs + 1) / 2))p"
+}
+
+printf '%-32s %8s\n' header ms
+for h in empty \
+         ctql/core.hpp \
+         include/htlist.hpp include/type_concepts.hpp include/predicates.hpp \
+         include/partition.hpp include/sorted.hpp include/reduce.hpp \
+         include/container_concepts.hpp include/function_traits.hpp include/extract.hpp \
+         include/value_list.hpp include/bin_pack.hpp include/layout.hpp include/hot_cold.hpp \
+         include/sharded.hpp include/serialize.hpp include/wire_view.hpp \
+         ctql.hpp; do
+    if [ "$h" = empty ]; then
+        : > "$tmp/tu.cpp"
+    else
+        printf '#include <%s>\n' "$h" > "$tmp/tu.cpp"
+    fi
+    printf '%-32s %8s\n' "$h" "$(measure)"
+done
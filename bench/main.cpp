@@ -0,0 +1,237 @@
+// ctql_bench: runtime cost of ctql-generated code next to the std equivalents.
+//
+//   dispatch  std::variant + std::visit   vs  ctql::batch_dispatch (grouped by type)
+//                                         vs  ctql::dispatcher (id + payload)
+//   layout    std::tuple rows             vs  ctql::field_block<align_sorted_t<...>> rows
+//   scans     array of tuples             vs  one array per field (SoA)
+//   logging   std::snprintf on the hot thread vs  ctql::log_ring (binary record, rendered later)
+//
+// Numbers are per event / row; see bench/harness.hpp for the counters.
+
+#include "harness.hpp"
+
+#include <cstring>
+#include <ctql.hpp>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+namespace {
+
+    using ctql_bench::keep;
+    using ctql_bench::run;
+    using ctql::operator""_ct;
+
+    constexpr std::size_t events = std::size_t{1} << 16;
+    constexpr std::size_t rows   = std::size_t{1} << 20;
+
+    // Deterministic pseudo-random stream (no <random> in the timed code).
+    struct lcg {
+        std::uint64_t state;
+        std::uint32_t operator()() noexcept {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            return static_cast<std::uint32_t>(state >> 33);
+        }
+    };
+
+    // ---- dispatch ----
+
+    template <std::size_t N, std::size_t I>
+    struct Msg {
+        static constexpr std::size_t id = I;
+        std::uint32_t v;
+        std::uint32_t w;
+    };
+
+    template <std::size_t N, std::size_t... Is>
+    void bench_dispatch(std::index_sequence<Is...>) {
+        using Event = std::variant<Msg<N, Is>...>;
+
+        struct packet {
+            std::uint32_t id;
+            std::array<std::byte, sizeof(Msg<N, 0>)> payload;
+        };
+
+        lcg next{N};
+        std::vector<Event> stored;
+        std::vector<packet> wire;
+        stored.reserve(events);
+        wire.reserve(events);
+        constexpr std::array<Event (*)(std::uint32_t), N> make{
+            +[](std::uint32_t v) { return Event{Msg<N, Is>{v, v ^ 1u}}; }...};
+        for (std::size_t i = 0; i < events; ++i) {
+            const std::uint32_t id = next() % N;
+            const std::uint32_t v  = next();
+            stored.push_back(make[id](v));
+            packet p{id, {}};
+            std::visit([&](const auto& m) { std::memcpy(p.payload.data(), &m, sizeof m); }, stored.back());
+            wire.push_back(p);
+        }
+
+        std::uint64_t sum = 0;
+        char name[64];
+
+        std::snprintf(name, sizeof name, "std::visit, %zu types", N);
+        run(name, events, [&] {
+            for (const Event& e : stored)
+                std::visit([&](const auto& m) { sum += m.v + std::remove_cvref_t<decltype(m)>::id; }, e);
+            keep(sum);
+        });
+
+        std::vector<std::uint32_t> order(events);
+        std::snprintf(name, sizeof name, "ctql::batch_dispatch, %zu types", N);
+        run(name, events, [&] {
+            ctql::batch_dispatch(std::span<const Event>{stored},
+                                 [&](const auto& m) { sum += m.v + std::remove_cvref_t<decltype(m)>::id; },
+                                 std::span{order});
+            keep(sum);
+        });
+
+        auto d = ctql::make_dispatcher([&sum](const Msg<N, Is>& m) { sum += m.v + Is; }...);
+        std::snprintf(name, sizeof name, "ctql::dispatcher, %zu types", N);
+        run(name, events, [&] {
+            for (const packet& p : wire)
+                d.dispatch(p.id, std::span<const std::byte>(p.payload));
+            keep(sum);
+        });
+    }
+
+    // ---- layout and scans ----
+
+    struct Flag  { bool on; };
+    struct Price { double v; };
+    struct Side  { char s; };
+    struct Qty   { std::int32_t n; };
+    struct Venue { std::uint16_t id; };
+    struct Stamp { std::int64_t ns; };
+    struct Live  { bool on; };
+
+    using Declared = std::tuple<Flag, Price, Side, Qty, Venue, Stamp, Live>;
+    using Packed   = ctql::field_block<ctql::align_sorted_t<Flag, Price, Side, Qty, Venue, Stamp, Live>>;
+
+    template <typename... Fs>
+    struct soa {
+        std::tuple<std::vector<Fs>...> columns;
+
+        explicit soa(std::size_t n)
+            : columns{std::vector<Fs>(n)...} { }
+
+        template <typename F>
+        std::vector<F>& column() {
+            return std::get<std::vector<F>>(columns);
+        }
+    };
+
+    void bench_layout() {
+        std::printf("row bytes: std::tuple %zu, field_block %zu\n\n", sizeof(Declared), sizeof(Packed));
+
+        lcg next{7};
+        std::vector<Declared> declared(rows);
+        std::vector<Packed> packed(rows);
+        soa<Flag, Price, Side, Qty, Venue, Stamp, Live> columns(rows);
+        for (std::size_t i = 0; i < rows; ++i) {
+            const Price p{static_cast<double>(next() % 10000) / 100};
+            const Qty q{static_cast<std::int32_t>(next() % 1000)};
+            std::get<Price>(declared[i]) = p;
+            std::get<Qty>(declared[i])   = q;
+            packed[i].get<Price>()       = p;
+            packed[i].get<Qty>()         = q;
+            columns.column<Price>()[i]   = p;
+            columns.column<Qty>()[i]     = q;
+        }
+
+        run("notional, std::tuple rows", rows, [&] {
+            double sum = 0;
+            for (const Declared& r : declared)
+                sum += std::get<Price>(r).v * std::get<Qty>(r).n;
+            keep(sum);
+        });
+        run("notional, field_block rows", rows, [&] {
+            double sum = 0;
+            for (const Packed& r : packed)
+                sum += r.get<Price>().v * r.get<Qty>().n;
+            keep(sum);
+        });
+        run("notional, SoA columns", rows, [&] {
+            double sum        = 0;
+            const auto& price = columns.column<Price>();
+            const auto& qty   = columns.column<Qty>();
+            for (std::size_t i = 0; i < rows; ++i)
+                sum += price[i].v * qty[i].n;
+            keep(sum);
+        });
+
+        std::printf("\n");
+        run("count qty < 100, std::tuple rows", rows, [&] {
+            std::size_t n = 0;
+            for (const Declared& r : declared)
+                n += std::get<Qty>(r).n < 100;
+            keep(n);
+        });
+        run("count qty < 100, SoA column", rows, [&] {
+            std::size_t n = 0;
+            for (const Qty& q : columns.column<Qty>())
+                n += q.n < 100;
+            keep(n);
+        });
+        std::vector<std::int32_t> qty(rows);
+        for (std::size_t i = 0; i < rows; ++i)
+            qty[i] = columns.column<Qty>()[i].n;
+        std::vector<std::uint64_t> bits(rows / 64);
+        run("count qty < 100, SoA + ctql::filter_bitmap", rows, [&] {
+            keep(ctql::filter_bitmap(ctql::ops::lt{}, 100, std::span{qty}, std::span{bits}));
+        });
+    }
+
+    // ---- logging ----
+
+    void bench_logging() {
+        lcg next{11};
+        std::vector<double> px(events);
+        std::vector<std::uint32_t> qty(events);
+        for (std::size_t i = 0; i < events; ++i) {
+            px[i]  = static_cast<double>(next() % 100000) / 100;
+            qty[i] = next() % 1000;
+        }
+
+        std::vector<char> text(events * 64);
+        run("std::snprintf \"fill px={} qty={}\"", events, [&] {
+            char* out = text.data();
+            for (std::size_t i = 0; i < events; ++i)
+                out += std::snprintf(out, 64, "fill px=%g qty=%u", px[i], qty[i]);
+            keep(text);
+        });
+
+        // Room for the warm-up and every timed call: only the hot-thread side is timed.
+        auto ring = std::make_unique<ctql::log_ring<std::size_t{1} << 24>>();
+        run("ctql::log_ring::log \"fill px={} qty={}\"", events, [&] {
+            for (std::size_t i = 0; i < events; ++i)
+                ring->log<"fill px={} qty={}"_ct>(px[i], qty[i]);
+            keep(ring);
+        });
+        std::size_t lines = 0;
+        ring->drain([&](std::string_view) { ++lines; });
+        keep(lines);
+    }
+
+} // namespace
+
+int main() {
+    std::printf("# ctql_bench\n");
+    if (!ctql_bench::counters().has_cycles())
+        std::printf("\n(perf_event_open unavailable: cycle and miss columns are empty)\n");
+
+    ctql_bench::section("dispatch");
+    bench_dispatch<4>(std::make_index_sequence<4>{});
+    bench_dispatch<16>(std::make_index_sequence<16>{});
+    bench_dispatch<64>(std::make_index_sequence<64>{});
+
+    ctql_bench::section("layout and scans");
+    bench_layout();
+
+    ctql_bench::section("logging");
+    bench_logging();
+    return 0;
+}
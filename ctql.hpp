@@ -1,13 +1,31 @@
 #pragma once
 
+#include "ctql/core.hpp"
 #include "include/concepts.hpp"
-#include "include/htlist.hpp"
-#include "include/predicates.hpp"
 #include "include/ct_string.inl"
-#include "include/sorted.hpp"
-#include "include/reduce.hpp"
-#include "include/partition.hpp"
+#include "include/value_list.hpp"
+#include "include/bin_pack.hpp"
+#include "include/layout.hpp"
+#include "include/hot_cold.hpp"
+#include "include/sharded.hpp"
+#include "include/serialize.hpp"
+#include "include/wire_view.hpp"
+#include "include/dispatch.hpp"
+#include "include/inplace_function.hpp"
+#include "include/size_class_allocator.hpp"
+#include "include/type_mask.hpp"
+#include "include/classifier.hpp"
+#include "include/query.hpp"
+#include "include/simd_filter.hpp"
+#include "include/match_dispatch.hpp"
+#include "include/typed_queues.hpp"
+#include "include/batch_dispatch.hpp"
+#include "include/string_pool.hpp"
+#include "include/binary_log.hpp"
+#include "include/flat_tuple.hpp"
+#include "include/type_id.hpp"
+#include "include/section_registry.hpp"
 
 #ifndef CTQL_NO_MACROS
 #include <include/macros.hpp>
-#endif
\ No newline at end of file
+#endif
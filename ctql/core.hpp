@@ -0,0 +1,25 @@
+#pragma once
+
+/// @file
+/// @brief The ctql algorithms without the heavy standard headers.
+/// @details
+/// Typelists, key wrappers, predicates, `partition_by*`, `sort_list` / `TypeSort`,
+/// the size reductions and key selection (`min_by_t`, `top_k_t`, ...). Depends on
+/// `<cstddef>`, `<type_traits>`, `<utility>`, `<concepts>` and `<array>` only; no
+/// `<functional>`, containers or `<variant>`.
+///
+/// Opt-in headers for the rest:
+/// - `include/container_concepts.hpp`: `is_vector`, `is_map`, `is_tuple`, ...
+/// - `include/function_traits.hpp`: `function_traits`, `is_function_with_signature`
+/// - `include/extract.hpp`: `to_tuple`, `to_variant`
+/// - `ctql.hpp`: everything, plus the macro layer.
+///
+/// `bench/include_cost.sh` reports the cost of including each header.
+
+#include "../include/htlist.hpp"
+#include "../include/type_concepts.hpp"
+#include "../include/predicates.hpp"
+#include "../include/partition.hpp"
+#include "../include/sorted.hpp"
+#include "../include/reduce.hpp"
+#include "../include/select.hpp"
@@ -1,3 +1,8 @@
+#define CTQL_ENABLE_DSL
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
 #include <variant>
 #include <tuple>
 #include <type_traits>
@@ -14,21 +19,37 @@ struct gt_size {
     static constexpr bool value = (E::size > P::size);
 };
 
-struct MsgLogin { };
-struct MsgPing { };
-struct MsgChunk { };
-struct MsgTelemetry { };
+struct MsgLogin { std::uint64_t user; char token[40]; };
+struct MsgPing { std::uint64_t seq; std::uint64_t sent_ns; };
+struct MsgChunk { std::uint64_t offset; std::byte data[4088]; };
+struct MsgTelemetry { std::uint64_t ts; std::uint32_t counters[62]; };
+struct MsgHeartbeat { std::uint64_t seq; std::uint32_t node; std::uint8_t peers[688]; };
+struct MsgStatus { std::uint64_t ts; char text[512]; };
 
+// Wire layout of each message, in wire order (see serialize.hpp).
 template <class>
-struct WireBytes;
+struct WireFields;
 template <>
-struct WireBytes<MsgLogin> : std::integral_constant<std::size_t, 48> { };
+struct WireFields<MsgLogin> { using type = $type_list(field<&MsgLogin::user>, field<&MsgLogin::token>); };
 template <>
-struct WireBytes<MsgPing> : std::integral_constant<std::size_t, 16> { };
+struct WireFields<MsgPing> { using type = $type_list(field<&MsgPing::seq>, field<&MsgPing::sent_ns>); };
 template <>
-struct WireBytes<MsgChunk> : std::integral_constant<std::size_t, 4096> { };
+struct WireFields<MsgChunk> { using type = $type_list(field<&MsgChunk::offset>, field<&MsgChunk::data>); };
 template <>
-struct WireBytes<MsgTelemetry> : std::integral_constant<std::size_t, 256> { };
+struct WireFields<MsgTelemetry> { using type = $type_list(field<&MsgTelemetry::ts>, field<&MsgTelemetry::counters>); };
+template <>
+struct WireFields<MsgHeartbeat> {
+    using type = $type_list(field<&MsgHeartbeat::seq>, field<&MsgHeartbeat::node>, field<&MsgHeartbeat::peers>);
+};
+template <>
+struct WireFields<MsgStatus> { using type = $type_list(field<&MsgStatus::ts>, field<&MsgStatus::text>); };
+
+template <class T>
+struct WireBytes : std::integral_constant<std::size_t, encoded_size_v<typename WireFields<T>::type>> { };
+
+static_assert(WireBytes<MsgLogin>::value == 48 && WireBytes<MsgPing>::value == 16 && WireBytes<MsgChunk>::value == 4096);
+static_assert(WireBytes<MsgTelemetry>::value == 256 && WireBytes<MsgHeartbeat>::value == 700
+              && WireBytes<MsgStatus>::value == 520);
 
 template <class T>
 struct WireSizeOf {
@@ -65,3 +86,57 @@ using FitsMtuSortedWrappers
 
 using FitsMtuSortedTuple
     = $to_tuple(FitsMtuSortedWrappers); // std::tuple<MsgPing, MsgLogin, MsgTelemetry>
+
+// Batch the periodic heartbeat bundle into as few MTU-sized frames as possible
+// (first-fit-decreasing): {700, 256, 48, 16} + {520} instead of five packets.
+using Heartbeat = ctql::bin_pack<1200, WireSizeOf, MsgHeartbeat, MsgStatus, MsgTelemetry, MsgLogin, MsgPing>;
+
+static_assert(Heartbeat::bins == 2);
+static_assert(Heartbeat::fill == std::array<std::size_t, 2>{1020, 520});
+static_assert(Heartbeat::waste == std::array<std::size_t, 2>{180, 680});
+static_assert($type_eq(
+    Heartbeat::type,
+    $type_list(
+        ctql::bin<1200, $type_list(WireSizeOf<MsgHeartbeat>, WireSizeOf<MsgTelemetry>, WireSizeOf<MsgLogin>, WireSizeOf<MsgPing>)>,
+        ctql::bin<1200, $type_list(WireSizeOf<MsgStatus>)>)
+));
+
+// The latest value of every message in the heartbeat bundle.
+using HeartbeatState = std::tuple<MsgHeartbeat, MsgStatus, MsgTelemetry, MsgLogin, MsgPing>;
+
+// One send per frame; each message is serialized into its WireBytes<T> slot.
+template <class Send>
+void send_heartbeat(const HeartbeatState& state, Send&& send) {
+    Heartbeat::emit(
+        [&]<class T>(std::span<std::byte> dst) {
+            serialize<typename WireFields<T>::type>(std::get<T>(state), dst.first<WireBytes<T>::value>());
+        },
+        std::forward<Send>(send));
+}
+
+// Classify runtime payload lengths against the same sorted keys: the smallest
+// message class whose wire size fits, without a hand-written if-chain.
+using PayloadClass = ctql::classifier<FitsMtuSortedWrappers>;
+
+static_assert(PayloadClass::bucket(16) == 0 && PayloadClass::bucket(17) == 1);
+static_assert(PayloadClass::bucket(5000) == PayloadClass::size); // larger than any message
+
+template <class OnMessage, class OnOversize>
+decltype(auto) route_payload(std::size_t len, OnMessage&& on_message, OnOversize&& on_oversize) {
+    return PayloadClass::dispatch(len, std::forward<OnMessage>(on_message), std::forward<OnOversize>(on_oversize));
+}
+
+int main() {
+    static HeartbeatState state{}; // ~1.5 KB; keep it off the stack
+    std::get<MsgPing>(state).seq = 7;
+
+    std::size_t frames = 0, bytes = 0;
+    send_heartbeat(state, [&](std::span<const std::byte> frame) {
+        ++frames;
+        bytes += frame.size();
+    });
+
+    const std::size_t cls = route_payload(
+        100, []<class K>() { return sizeof(typename K::type); }, [] { return std::size_t{0}; });
+    return frames == Heartbeat::bins && bytes == 1020 + 520 && cls == sizeof(MsgTelemetry) ? 0 : 1;
+}
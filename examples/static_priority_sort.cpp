@@ -1,3 +1,4 @@
+#define CTQL_ENABLE_DSL
 #include <iostream>
 #include <ctql.hpp>
 
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "extract.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+/// @file
+/// @brief Visit a runtime array of variants one alternative at a time.
+/// @details
+/// `std::visit` over a mixed array picks a handler per message: the branch predictor
+/// sees a new target almost every time, and each handler's code and data go cold
+/// between its messages. `batch_dispatch` sorts first and visits second:
+///
+/// 1. one pass counts each alternative (a histogram with one slot per alternative,
+///    sized at compile time) and turns the counts into bucket offsets;
+/// 2. the messages are grouped by alternative;
+/// 3. for each alternative `I` in order, `handler(std::get<I>(m))` runs over its
+///    whole bucket in one loop, with no dispatch inside.
+///
+/// Two groupings:
+/// - `batch_dispatch(msgs, handler, order)`: a stable counting sort of the message
+///   positions into @p order (one `uint32_t` per message). @p msgs is left untouched
+///   and each type's messages are handled in their original order.
+/// - `batch_dispatch_in_place(msgs, handler)`: swaps the messages themselves into
+///   buckets (one American-flag pass, no scratch), so each bucket is contiguous.
+///   The order within a type is not preserved.
+///
+/// Any `std::variant` works; `to_variant<List>::type` builds one from a key list.
+/// Valueless variants are skipped.
+///
+/// ### Example
+///
+/// @code{.cpp}
+/// using Event = ctql::to_variant<ctql::TypeSort<ctql::Order::Asc, ctql::Size, Quote, Trade, Halt>>::type;
+///
+/// std::vector<Event> inbox = poll();
+/// std::vector<std::uint32_t> order(inbox.size());
+///
+/// ctql::batch_dispatch(std::span<const Event>{inbox}, [&](const auto& m) { book.apply(m); },
+///                      std::span{order});
+/// @endcode
+
+namespace ctql {
+
+    /// @cond INTERNAL
+    namespace detail {
+
+        template <typename V>
+        inline constexpr bool is_std_variant = false;
+
+        template <typename... Ts>
+        inline constexpr bool is_std_variant<std::variant<Ts...>> = true;
+
+        // Bucket of a message: its alternative, or the extra last slot when valueless.
+        template <typename V>
+        inline std::size_t batch_bucket(const V& v) noexcept {
+            const std::size_t i = v.index();
+            return i < std::variant_size_v<std::remove_const_t<V>> ? i : std::variant_size_v<std::remove_const_t<V>>;
+        }
+
+        template <typename V>
+        using batch_counts = std::array<std::size_t, std::variant_size_v<std::remove_const_t<V>> + 1>;
+
+        // counts[b] becomes the start of bucket b; returns the per-bucket sizes.
+        template <typename V>
+        inline batch_counts<V> batch_histogram(std::span<V> msgs, batch_counts<V>& start) noexcept {
+            batch_counts<V> counts{};
+            for (const auto& m : msgs)
+                ++counts[batch_bucket(m)];
+            std::size_t at = 0;
+            for (std::size_t b = 0; b < counts.size(); ++b) {
+                start[b] = at;
+                at += counts[b];
+            }
+            return counts;
+        }
+
+        template <typename V, typename H>
+        inline constexpr bool batch_handles = []<std::size_t... Is>(std::index_sequence<Is...>) {
+            return (std::is_invocable_v<H&, decltype(std::get<Is>(std::declval<V&>()))> && ...);
+        }(std::make_index_sequence<std::variant_size_v<std::remove_const_t<V>>>{});
+
+    } // namespace detail
+    /// @endcond
+
+    /**
+     * @brief Group @p msgs by alternative and call `handler(std::get<I>(m))` bucket by bucket.
+     * @details Stable: within an alternative, messages are handled in their order in @p msgs.
+     * @param msgs    Messages; not modified.
+     * @param handler Callable with every alternative, e.g. a generic lambda.
+     * @param order   Scratch; room for `msgs.size()` positions. Holds the positions
+     *                grouped by alternative on return.
+     * @returns Number of messages of each alternative.
+     * @pre `order.size() >= msgs.size()` and `msgs.size() <= 2^32 - 1` (checked by `assert`).
+     */
+    template <typename V, typename Handler>
+        requires detail::is_std_variant<std::remove_const_t<V>> && detail::batch_handles<const V, Handler>
+    auto batch_dispatch(std::span<V> msgs, Handler&& handler, std::span<std::uint32_t> order) {
+        constexpr std::size_t N = std::variant_size_v<std::remove_const_t<V>>;
+        assert(order.size() >= msgs.size() && "batch_dispatch: order is shorter than msgs");
+        assert(msgs.size() <= std::numeric_limits<std::uint32_t>::max() && "batch_dispatch: too many messages for order");
+
+        detail::batch_counts<V> next{};
+        const auto counts = detail::batch_histogram(msgs, next);
+        const auto start  = next;
+        for (std::size_t i = 0; i < msgs.size(); ++i)
+            order[next[detail::batch_bucket(msgs[i])]++] = static_cast<std::uint32_t>(i);
+
+        [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            (
+                [&] {
+                    for (std::size_t k = start[Is]; k != start[Is] + counts[Is]; ++k)
+                        handler(*std::get_if<Is>(&std::as_const(msgs[order[k]])));
+                }(),
+                ...);
+        }(std::make_index_sequence<N>{});
+
+        std::array<std::size_t, N> out{};
+        std::copy_n(counts.begin(), N, out.begin());
+        return out;
+    }
+
+    /**
+     * @brief Reorder @p msgs into one contiguous run per alternative, then call
+     *        `handler(std::get<I>(m))` run by run.
+     * @details Runs follow the alternative order; valueless messages end up last.
+     *          Messages are swapped, not copied, and their order within a run is unspecified.
+     * @param msgs    Messages; permuted in place. The handler receives them by non-const reference.
+     * @param handler Callable with every alternative, e.g. a generic lambda.
+     * @returns Number of messages of each alternative; run `I` starts after the previous runs.
+     */
+    template <typename V, typename Handler>
+        requires detail::is_std_variant<V> && detail::batch_handles<V, Handler>
+    auto batch_dispatch_in_place(std::span<V> msgs, Handler&& handler) {
+        constexpr std::size_t N = std::variant_size_v<V>;
+
+        detail::batch_counts<V> next{};
+        const auto counts = detail::batch_histogram(msgs, next);
+        const auto start  = next;
+
+        // Fill bucket b from its cursor: a message already in place advances the cursor,
+        // any other is swapped to the cursor of its own bucket.
+        for (std::size_t b = 0; b < N; ++b) {
+            const std::size_t end = start[b] + counts[b];
+            while (next[b] != end) {
+                const std::size_t home = detail::batch_bucket(msgs[next[b]]);
+                if (home == b)
+                    ++next[b];
+                else {
+                    using std::swap;
+                    swap(msgs[next[b]], msgs[next[home]++]);
+                }
+            }
+        }
+
+        [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            (
+                [&] {
+                    for (std::size_t k = start[Is]; k != start[Is] + counts[Is]; ++k)
+                        handler(*std::get_if<Is>(&msgs[k]));
+                }(),
+                ...);
+        }(std::make_index_sequence<N>{});
+
+        std::array<std::size_t, N> out{};
+        std::copy_n(counts.begin(), N, out.begin());
+        return out;
+    }
+
+} // namespace ctql
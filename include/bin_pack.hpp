@@ -0,0 +1,211 @@
+#pragma once
+
+#include "htlist.hpp"
+#include "predicates.hpp"
+#include "reduce.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <utility>
+
+/// @file
+/// @brief Compile-time first-fit-decreasing bin packing of keyed types.
+/// @details
+/// `bin_pack<Capacity, KeyOf, Ts...>` places every `KeyOf<T>` (which must satisfy
+/// `HasStaticSize`) into bins of `Capacity` size units using first-fit-decreasing:
+/// items are visited largest first and go into the first bin with room left.
+/// The result is an `HTList` of @ref bin types, each carrying its items, fill,
+/// wasted capacity and per-item offsets.
+///
+/// `build_frame` and `bin_pack::emit` are the runtime side: they lay out the items of
+/// each bin back to back in one buffer, so a bundle of messages leaves as one frame
+/// per bin instead of one send per message.
+///
+/// ### Example
+///
+/// @code{.cpp}
+/// template <class T> struct Wire { using type = T; static constexpr std::size_t size = T::wire_size; };
+///
+/// using Frames = ctql::bin_pack<1200, Wire, Login, Ping, Telemetry, Chunk>;
+/// static_assert(Frames::bins == 2);
+///
+/// Frames::emit(
+///     []<class T>(std::span<std::byte> dst) { encode<T>(dst); },  // fills exactly Wire<T>::size bytes
+///     [&](std::span<const std::byte> frame) { socket.send(frame); });
+/// @endcode
+///
+/// @note Packing is deterministic: equal-sized items keep their input order.
+/// @complexity One constant evaluation, O(n * bins) steps; O(n) instantiations.
+
+namespace ctql {
+
+    /**
+     * @brief One packed bin.
+     * @tparam Capacity Bin capacity in size units.
+     * @tparam Items    `detail::HTList<...>` of key types placed in this bin, in placement order.
+     */
+    template <std::size_t Capacity, typename Items>
+    struct bin;
+
+    template <std::size_t Capacity, HasStaticSize... Ks>
+    struct bin<Capacity, detail::HTList<Ks...>> {
+        using items = detail::HTList<Ks...>;
+
+        static constexpr std::size_t capacity = Capacity;
+        /// @brief Sum of the item sizes.
+        static constexpr std::size_t fill = Sum_v<Ks...>;
+        /// @brief Capacity left unused.
+        static constexpr std::size_t waste = Capacity - fill;
+
+        /// @brief Byte offset of each item when laid out back to back.
+        static constexpr std::array<std::size_t, sizeof...(Ks)> offsets = exclusive_scan_v<Size, Ks...>;
+
+        static_assert(fill <= Capacity, "bin: items exceed capacity");
+    };
+
+    /// @cond INTERNAL
+    namespace detail {
+
+        template <std::size_t N>
+        struct ffd_plan {
+            std::array<std::size_t, N> bin_of{}; // bin index per input item
+            std::array<std::size_t, N> order{};  // input indices in placement order
+            std::array<std::size_t, N> fill{};   // fill per bin
+            std::size_t bins = 0;
+        };
+
+        template <std::size_t N>
+        consteval ffd_plan<N> first_fit_decreasing(std::array<std::size_t, N> sizes, std::size_t cap) {
+            ffd_plan<N> plan;
+            for (std::size_t i = 0; i < N; ++i)
+                plan.order[i] = i;
+            // Largest first; ties keep input order.
+            std::sort(plan.order.begin(), plan.order.end(), [&](std::size_t a, std::size_t b) {
+                return sizes[a] != sizes[b] ? sizes[a] > sizes[b] : a < b;
+            });
+
+            for (std::size_t idx : plan.order) {
+                std::size_t b = 0;
+                while (b < plan.bins && plan.fill[b] + sizes[idx] > cap)
+                    ++b;
+                if (b == plan.bins)
+                    ++plan.bins;
+                plan.fill[b] += sizes[idx];
+                plan.bin_of[idx] = b;
+            }
+            return plan;
+        }
+
+        // Input indices assigned to bin B, in placement order.
+        template <std::size_t N>
+        struct bin_members {
+            std::array<std::size_t, N> idx{};
+            std::size_t len = 0;
+        };
+
+        template <std::size_t N>
+        consteval bin_members<N> members_of(const ffd_plan<N>& plan, std::size_t b) {
+            bin_members<N> out;
+            for (std::size_t idx : plan.order)
+                if (plan.bin_of[idx] == b)
+                    out.idx[out.len++] = idx;
+            return out;
+        }
+
+        template <std::size_t Capacity, typename Keys, auto Members, typename Seq = std::make_index_sequence<Members.len>>
+        struct make_bin;
+
+        template <std::size_t Capacity, typename Keys, auto Members, std::size_t... Is>
+        struct make_bin<Capacity, Keys, Members, std::index_sequence<Is...>> {
+            using type = bin<Capacity, HTList<type_at_t<Members.idx[Is], Keys>...>>;
+        };
+
+        template <std::size_t Capacity, typename Keys, auto Plan, typename Seq = std::make_index_sequence<Plan.bins>>
+        struct make_bins;
+
+        template <std::size_t Capacity, typename Keys, auto Plan, std::size_t... Bs>
+        struct make_bins<Capacity, Keys, Plan, std::index_sequence<Bs...>> {
+            using type = HTList<typename make_bin<Capacity, Keys, members_of(Plan, Bs)>::type...>;
+        };
+
+    } // namespace detail
+    /// @endcond
+
+    /**
+     * @brief Write the items of one @ref bin back to back into a frame buffer.
+     * @tparam Bin    A @ref bin.
+     * @param out     Frame buffer of exactly `Bin::capacity` bytes.
+     * @param encode  Callable invoked as `encode.template operator()<typename K::type>(dst)`
+     *                for each item key `K`, where `dst` is the item's `K::size`-byte slot.
+     * @returns Number of bytes used (`Bin::fill`).
+     */
+    template <typename Bin, typename Encode>
+    constexpr std::size_t build_frame(std::span<std::byte, Bin::capacity> out, Encode&& encode) {
+        [&]<typename... Ks, std::size_t... Is>(detail::HTList<Ks...>*, std::index_sequence<Is...>) {
+            (encode.template operator()<typename Ks::type>(out.subspan(Bin::offsets[Is], Ks::size)), ...);
+        }(static_cast<typename Bin::items*>(nullptr), std::make_index_sequence<Bin::items::len>{});
+        return Bin::fill;
+    }
+
+    /**
+     * @brief First-fit-decreasing packing of `KeyOf<Ts>...` into bins of @p Capacity.
+     * @tparam Capacity Bin capacity (e.g. an MTU in bytes).
+     * @tparam KeyOf    Unary key wrapper; `KeyOf<T>::size` is the item size.
+     * @tparam Ts       Items to pack; each key must fit into one bin.
+     *
+     * @details
+     * - `type`: `detail::HTList<bin<Capacity, ...>...>`, one @ref bin per frame.
+     * - `bins`: number of bins.
+     * - `fill`, `waste`: per-bin used and unused capacity.
+     */
+    template <std::size_t Capacity, template <typename> class KeyOf, typename... Ts>
+    struct bin_pack {
+        static_assert(((static_cast<std::size_t>(KeyOf<Ts>::size) <= Capacity) && ...),
+                      "bin_pack: an item is larger than the bin capacity");
+
+    private:
+        using keys = detail::HTList<KeyOf<Ts>...>;
+
+        static constexpr auto plan = detail::first_fit_decreasing<sizeof...(Ts)>(
+            {static_cast<std::size_t>(KeyOf<Ts>::size)...}, Capacity);
+
+    public:
+        using type = typename detail::make_bins<Capacity, keys, plan>::type;
+
+        static constexpr std::size_t bins = plan.bins;
+
+        static constexpr std::array<std::size_t, bins> fill = [] {
+            std::array<std::size_t, bins> out{};
+            for (std::size_t b = 0; b < bins; ++b)
+                out[b] = plan.fill[b];
+            return out;
+        }();
+
+        static constexpr std::array<std::size_t, bins> waste = [] {
+            std::array<std::size_t, bins> out{};
+            for (std::size_t b = 0; b < bins; ++b)
+                out[b] = Capacity - plan.fill[b];
+            return out;
+        }();
+
+        /**
+         * @brief Build every frame in turn in one stack buffer and hand it to @p send.
+         * @param encode See @ref build_frame.
+         * @param send   Callable invoked once per bin with `std::span<const std::byte>`
+         *               covering the bin's used bytes.
+         */
+        template <typename Encode, typename Send>
+        static void emit(Encode&& encode, Send&& send) {
+            std::array<std::byte, Capacity> buffer;
+            [&]<typename... Bins>(detail::HTList<Bins...>*) {
+                ((send(std::span<const std::byte>(buffer.data(), build_frame<Bins>(buffer, encode)))), ...);
+            }(static_cast<type*>(nullptr));
+        }
+    };
+
+    /// @brief The `HTList` of bins produced by @ref bin_pack.
+    template <std::size_t Capacity, template <typename> class KeyOf, typename... Ts>
+    using bin_pack_t = typename bin_pack<Capacity, KeyOf, Ts...>::type;
+
+} // namespace ctql
@@ -0,0 +1,271 @@
+#pragma once
+
+#include "sharded.hpp"
+#include <array>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ct_string.inl>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+/// @file
+/// @brief `"{}"` format strings parsed at compile time, logged as binary records.
+/// @details
+/// `fmt`-style logging parses the format string and renders text on the calling
+/// thread. Here the format string is a `ct_string` template argument:
+///
+/// - `format_spec<Fmt>` splits it at compile time into literal text and `{}`
+///   placeholders (`{{` and `}}` stand for braces); a wrong argument count is a
+///   compile error;
+/// - `log_ring::log<Fmt>(args...)` writes one record: a pointer to the static
+///   descriptor of (`Fmt`, argument types), then each argument's bytes. No parsing,
+///   no formatting, no allocation;
+/// - `log_ring::drain(fn)`, on another thread, renders each record to text through
+///   the descriptor and hands `fn` a `std::string_view` per line.
+///
+/// Arguments are arithmetic or enum values (printed as their underlying type), stored
+/// as is. A ring has one producer (keep one per logging thread, e.g. `thread_local`)
+/// and one consumer. Records hold descriptor addresses, so they are decoded by the
+/// process that wrote them.
+///
+/// ### Example
+///
+/// @code{.cpp}
+/// thread_local ctql::log_ring<1 << 16> trace; // registered with the writer thread at startup
+///
+/// trace.log<"fill px={} qty={} side={}"_ct>(px, qty, side);   // hot path: ~one memcpy per argument
+///
+/// trace.drain([&](std::string_view line) { file << line << '\n'; }); // writer thread
+/// @endcode
+
+namespace ctql {
+
+    /// @brief Argument types accepted by @ref log_ring::log.
+    template <typename T>
+    concept log_argument = std::is_arithmetic_v<T> || std::is_enum_v<T>;
+
+    /// @cond INTERNAL
+    namespace detail {
+
+        template <std::size_t N>
+        struct parsed_format {
+            std::array<char, N + 1> text{};
+            std::array<std::size_t, N + 1> cut{};
+            std::size_t length = 0;
+            std::size_t args   = 0;
+            bool ok            = true;
+        };
+
+        template <std::size_t N>
+        consteval parsed_format<N> parse_format(const ct_string<N>& fmt) {
+            parsed_format<N> p{};
+            const auto& s = fmt.data;
+            for (std::size_t i = 0; i < N; ++i) {
+                if (s[i] == '{' && i + 1 < N && s[i + 1] == '}')
+                    p.cut[p.args++] = p.length, ++i;
+                else if ((s[i] == '{' || s[i] == '}') && i + 1 < N && s[i + 1] == s[i])
+                    p.text[p.length++] = s[i++];
+                else if (s[i] == '{' || s[i] == '}')
+                    p.ok = false;
+                else
+                    p.text[p.length++] = s[i];
+            }
+            p.cut[p.args] = p.length;
+            return p;
+        }
+
+    } // namespace detail
+    /// @endcond
+
+    /**
+     * @brief Compile-time split of @p Fmt into literal text and `{}` placeholders.
+     * @details `{{` and `}}` are literal braces; any other brace is a compile error.
+     */
+    template <ct_string Fmt>
+    struct format_spec {
+    private:
+        static constexpr auto spec = detail::parse_format(Fmt);
+
+        static_assert(spec.ok, "format_spec: only {}, {{ and }} may contain braces");
+
+    public:
+        /// @brief Number of `{}` placeholders.
+        static constexpr std::size_t args = spec.args;
+
+        /// @brief Literal text before placeholder @p i (`i == args`: the text after the last one).
+        static constexpr std::string_view literal(std::size_t i) noexcept {
+            const std::size_t from = i == 0 ? 0 : spec.cut[i - 1];
+            return {spec.text.data() + from, spec.cut[i] - from};
+        }
+    };
+
+    /// @cond INTERNAL
+    namespace detail {
+
+        // What a record needs to be read back: its size and how to render its arguments.
+        struct log_site {
+            std::size_t bytes;
+            void (*render)(const std::byte* args, std::string& out);
+        };
+
+        inline constexpr std::size_t log_align = alignof(std::max_align_t) < 8 ? alignof(std::max_align_t) : 8;
+
+        template <typename T>
+        void log_append(std::string& out, T v) {
+            if constexpr (std::is_enum_v<T>)
+                log_append(out, static_cast<std::underlying_type_t<T>>(v));
+            else if constexpr (std::is_same_v<T, bool>)
+                out += v ? "true" : "false";
+            else if constexpr (std::is_same_v<T, char>)
+                out += v;
+            else if constexpr (std::is_same_v<T, wchar_t> || std::is_same_v<T, char8_t> || std::is_same_v<T, char16_t>
+                               || std::is_same_v<T, char32_t>)
+                log_append(out, static_cast<std::uint32_t>(v));
+            else {
+                char buf[64];
+                const auto r = std::to_chars(buf, buf + sizeof buf, v);
+                out.append(buf, r.ptr);
+            }
+        }
+
+        template <typename... Ts>
+        inline constexpr std::size_t log_payload = (std::size_t{0} + ... + sizeof(Ts));
+
+        // Offset of each argument in the payload.
+        template <typename... Ts>
+        inline constexpr std::array<std::size_t, sizeof...(Ts)> log_offsets = [] {
+            std::array<std::size_t, sizeof...(Ts)> out{};
+            std::size_t at = 0, i = 0;
+            ((out[i++] = at, at += sizeof(Ts)), ...);
+            return out;
+        }();
+
+        template <typename T>
+        void log_render_arg(const std::byte* in, std::string_view literal, std::string& out) {
+            T v;
+            std::memcpy(&v, in, sizeof v);
+            out += literal;
+            log_append(out, v);
+        }
+
+        template <ct_string Fmt, typename... Ts>
+        void log_render(const std::byte* args, std::string& out) {
+            using spec = format_spec<Fmt>;
+            [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                (log_render_arg<Ts>(args + log_offsets<Ts...>[Is], spec::literal(Is), out), ...);
+            }(std::index_sequence_for<Ts...>{});
+            out += spec::literal(sizeof...(Ts));
+        }
+
+        template <ct_string Fmt, typename... Ts>
+        inline constexpr log_site log_site_v{
+            (sizeof(const log_site*) + log_payload<Ts...> + log_align - 1) / log_align * log_align,
+            &log_render<Fmt, Ts...>};
+
+    } // namespace detail
+    /// @endcond
+
+    /**
+     * @brief Single-producer / single-consumer byte ring of binary log records.
+     * @tparam Bytes Capacity; a power of two. A record may take at most half of it, so
+     *               that it still fits, after the padding of a wrap, in an empty ring.
+     */
+    template <std::size_t Bytes>
+    class log_ring {
+        static_assert(std::has_single_bit(Bytes) && Bytes >= 64, "log_ring: capacity must be a power of two >= 64");
+
+    public:
+        log_ring() = default;
+
+        log_ring(const log_ring&)            = delete;
+        log_ring& operator=(const log_ring&) = delete;
+
+        /**
+         * @brief Producer: append a record of @p Fmt and @p args.
+         * @returns `false`, writing nothing, if the ring is full.
+         */
+        template <ct_string Fmt, typename... Args>
+            requires(log_argument<std::remove_cvref_t<Args>> && ...)
+        bool log(const Args&... args) noexcept {
+            static_assert(sizeof...(Args) == format_spec<Fmt>::args, "log_ring::log: argument count differs from the {} count");
+            constexpr const detail::log_site* site = &detail::log_site_v<Fmt, std::remove_cvref_t<Args>...>;
+            static_assert(site->bytes <= Bytes / 2, "log_ring::log: record larger than half the ring");
+
+            std::byte* rec = reserve(site->bytes);
+            if (rec == nullptr)
+                return false;
+            std::memcpy(rec, &site, sizeof site);
+            std::size_t at = sizeof site;
+            ((std::memcpy(rec + at, &args, sizeof args), at += sizeof args), ...);
+            tail_.store(pending_, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Consumer: render every record written so far, oldest first.
+         * @param fn Called with each line as a `std::string_view`, valid until it returns.
+         * @returns Number of records.
+         */
+        template <typename F>
+        std::size_t drain(F&& fn) {
+            std::size_t head       = head_.load(std::memory_order_relaxed);
+            const std::size_t tail = tail_.load(std::memory_order_acquire);
+            std::size_t n          = 0;
+            while (head != tail) {
+                const std::size_t pos = head & (Bytes - 1);
+                const detail::log_site* site;
+                std::memcpy(&site, storage_ + pos, sizeof site);
+                if (site == nullptr) { // padding up to the end of the ring
+                    head += Bytes - pos;
+                    continue;
+                }
+                line_.clear();
+                site->render(storage_ + pos + sizeof site, line_);
+                fn(std::string_view(line_));
+                head += site->bytes;
+                ++n;
+            }
+            head_.store(head, std::memory_order_release);
+            return n;
+        }
+
+        /// @brief Consumer: `true` if no record is waiting.
+        bool empty() const noexcept {
+            return tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_relaxed);
+        }
+
+    private:
+        // Room for one record, contiguous: a record that would straddle the end is
+        // preceded by a null-site padding record and starts at offset 0.
+        std::byte* reserve(std::size_t bytes) noexcept {
+            const std::size_t tail = tail_.load(std::memory_order_relaxed);
+            const std::size_t pos  = tail & (Bytes - 1);
+            const std::size_t pad  = Bytes - pos < bytes ? Bytes - pos : 0;
+            if (Bytes - (tail - head_cache_) < pad + bytes) {
+                head_cache_ = head_.load(std::memory_order_acquire);
+                if (Bytes - (tail - head_cache_) < pad + bytes)
+                    return nullptr;
+            }
+            if (pad != 0) {
+                const detail::log_site* none = nullptr;
+                std::memcpy(storage_ + pos, &none, sizeof none);
+            }
+            pending_ = tail + pad + bytes;
+            return storage_ + (pad != 0 ? 0 : pos);
+        }
+
+        alignas(destructive_interference_size) std::atomic<std::size_t> tail_{0};
+        std::size_t head_cache_ = 0; // producer's last view of head_
+        std::size_t pending_    = 0; // tail after the record being written
+        alignas(destructive_interference_size) std::atomic<std::size_t> head_{0};
+        std::string line_; // consumer's render buffer
+        alignas(destructive_interference_size) alignas(detail::log_align) std::byte storage_[Bytes];
+    };
+
+} // namespace ctql
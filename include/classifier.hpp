@@ -0,0 +1,145 @@
+#pragma once
+
+#include "htlist.hpp"
+#include "predicates.hpp"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+/// @file
+/// @brief Branchless runtime classification of a value against a sorted key list.
+/// @details
+/// `classifier<HTList<Ks...>>` takes keys sorted by ascending `size`, typically a
+/// `TypeSort<Order::Asc, KeyOf, Ts...>`. `bucket(x)` is the index of the first key
+/// with `x <= size`, or `sizeof...(Ks)` if `x` exceeds them all. This is the
+/// smallest class that fits `x`, computed from the same list the compile-time code
+/// uses.
+///
+/// The lookup has no data-dependent branches:
+/// - up to `linear_max` keys, it counts the keys below `x` over a constexpr array,
+///   a loop the compiler vectorizes into a few compares and a horizontal add;
+/// - beyond that, it descends an Eytzinger (BFS-order) copy of the keys. The copy
+///   is padded to a complete tree, so the descent runs a fixed `height` steps.
+///
+/// ### Example
+///
+/// @code{.cpp}
+/// using Classes = ctql::TypeSort<ctql::Order::Asc, WireSizeOf, MsgLogin, MsgPing, MsgTelemetry>;
+/// using Fit     = ctql::classifier<Classes>;
+///
+/// std::size_t b = Fit::bucket(len);          // 0: Ping, 1: Login, 2: Telemetry, 3: too big
+/// Fit::dispatch(len,
+///     []<class K>() { send_as<typename K::type>(); },
+///     [] { fragment(); });
+/// @endcode
+
+namespace ctql {
+
+    template <typename Keys>
+    class classifier;
+
+    /**
+     * @brief Runtime `size_t -> bucket` lookup over the sorted keys @p Ks.
+     * @tparam Ks Keys satisfying `HasStaticSize`, in non-decreasing `size` order.
+     */
+    template <HasStaticSize... Ks>
+    class classifier<detail::HTList<Ks...>> {
+    public:
+        using keys = detail::HTList<Ks...>;
+
+        /// @brief Number of keys; bucket `size` means "above every key".
+        static constexpr std::size_t size = sizeof...(Ks);
+
+        /// @brief Number of buckets (`size + 1`).
+        static constexpr std::size_t buckets = size + 1;
+
+        /// @brief Key sizes in order.
+        static constexpr std::array<std::size_t, size> bounds{static_cast<std::size_t>(Ks::size)...};
+
+        static_assert(
+            [] {
+                for (std::size_t i = 1; i < size; ++i)
+                    if (bounds[i - 1] > bounds[i])
+                        return false;
+                return true;
+            }(),
+            "classifier: keys must be sorted by ascending size");
+
+        /// @brief Largest key count searched by a linear count instead of the Eytzinger tree.
+        static constexpr std::size_t linear_max = 16;
+
+        /// @brief Levels of the Eytzinger tree.
+        static constexpr std::size_t height = std::bit_width(size);
+
+    private:
+        static constexpr std::size_t slots = std::size_t{1} << height; // slot 0 unused
+
+        struct layout {
+            std::array<std::size_t, slots> key{};  // BFS order, padded with the maximum
+            std::array<std::size_t, slots> rank{}; // slot -> bucket; rank[0] = size
+        };
+
+        // In-order walk of the complete tree assigns the sorted keys, then the padding.
+        static constexpr layout eytzinger = [] {
+            layout out;
+            std::size_t next = 0;
+            auto fill        = [&](auto& self, std::size_t k) -> void {
+                if (k >= slots)
+                    return;
+                self(self, 2 * k);
+                out.key[k]  = next < size ? bounds[next] : std::numeric_limits<std::size_t>::max();
+                out.rank[k] = next < size ? next : size;
+                ++next;
+                self(self, 2 * k + 1);
+            };
+            fill(fill, 1);
+            out.rank[0] = size;
+            return out;
+        }();
+
+    public:
+        /// @brief Index of the first key with `x <= size`, or `size` if there is none.
+        static constexpr std::size_t bucket(std::size_t x) noexcept {
+            if constexpr (size <= linear_max) {
+                std::size_t below = 0;
+                for (std::size_t b : bounds)
+                    below += b < x;
+                return below;
+            } else {
+                std::size_t k = 1;
+                for (std::size_t level = 0; level < height; ++level)
+                    k = 2 * k + (eytzinger.key[k] < x);
+                k >>= std::countr_one(k) + 1;
+                return eytzinger.rank[k];
+            }
+        }
+
+        /// @brief Same as @ref bucket.
+        constexpr std::size_t operator()(std::size_t x) const noexcept { return bucket(x); }
+
+        /**
+         * @brief Run the handler of the bucket of @p x.
+         * @param on_key      Called as `on_key.template operator()<K>()` with the key `K` of the bucket.
+         * @param on_overflow Called as `on_overflow()` when @p x exceeds every key.
+         * @details One table load and one indirect call; both handlers must return the same type.
+         */
+        template <typename OnKey, typename OnOverflow>
+        static constexpr decltype(auto) dispatch(std::size_t x, OnKey&& on_key, OnOverflow&& on_overflow) {
+            using K = std::remove_reference_t<OnKey>;
+            using O = std::remove_reference_t<OnOverflow>;
+            using R = decltype(on_overflow());
+
+            constexpr auto table = []<std::size_t... Is>(std::index_sequence<Is...>) {
+                return std::array<R (*)(K&, O&), buckets>{
+                    +[](K& k, O&) -> R { return k.template operator()<detail::type_at_t<Is, keys>>(); }...,
+                    +[](K&, O& o) -> R { return o(); }};
+            }(std::make_index_sequence<size>{});
+
+            return table[bucket(x)](on_key, on_overflow);
+        }
+    };
+
+} // namespace ctql
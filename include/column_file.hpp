@@ -0,0 +1,323 @@
+#pragma once
+
+#include "htlist.hpp"
+#include "predicates.hpp"
+#include "reduce.hpp"
+#include "type_id.hpp"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<sys/mman.h>)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+/// @file
+/// @brief Columnar snapshot files laid out from an `HTList` schema, read back by `mmap`.
+/// @details
+/// `column_file<HTList<Fs...>>` stores one column per field type `F`, each a plain
+/// array of `F`:
+///
+/// - a header block: magic, a schema hash, the row count and the byte offset of
+///   every column, padded to 64 bytes;
+/// - the column blocks, in schema order. Each holds `stride` elements, the row count
+///   rounded up to a multiple of 64, so every block starts on a 64-byte boundary and
+///   block `i` sits at `header_bytes + stride * exclusive_scan_v<SizeOf, Fs...>[i]`.
+///
+/// The schema hash mixes `stable_type_id_v`, size and alignment of every field and
+/// the byte order; a file written with another schema (or by another compiler, whose
+/// type names may be spelled differently) is refused.
+///
+/// `write` streams the columns out. `open` maps the file read-only and checks the
+/// header; `column<F>()` is then a `std::span` straight into the mapping, so opening
+/// costs the same for any file size and pages are read on first touch.
+///
+/// Opt-in: POSIX only, and not included by `ctql.hpp`, since it brings in
+/// `<sys/mman.h>`, `<fcntl.h>` and `<unistd.h>`.
+///
+/// ### Example
+///
+/// @code{.cpp}
+/// using Ticks = ctql::column_file<ctql::detail::HTList<Timestamp, Price, Qty>>;
+///
+/// Ticks::write("ticks.col", std::span{ts}, std::span{px}, std::span{qty});
+///
+/// Ticks snap;
+/// if (snap.open("ticks.col") == ctql::column_file_error::none)
+///     for (Price p : snap.column<Price>()) vwap.add(p);
+/// @endcode
+
+#if __has_include(<sys/mman.h>)
+
+namespace ctql {
+
+    /// @brief Outcome of @ref column_file::write and @ref column_file::open.
+    enum class column_file_error {
+        none,            ///< Success.
+        open_failed,     ///< The file could not be created or opened.
+        io_failed,       ///< A write, `fstat` or `mmap` failed.
+        ragged_columns,  ///< `write` was given columns of different lengths.
+        bad_header,      ///< Not a column file, or its layout is inconsistent.
+        schema_mismatch, ///< Written with another schema.
+        truncated,       ///< Shorter than its header says.
+    };
+
+    /// @cond INTERNAL
+    namespace detail {
+
+        inline constexpr std::size_t column_align = 64;
+
+        inline constexpr std::array<char, 8> column_magic{'c', 't', 'q', 'l', 'c', 'o', 'l', '1'};
+
+        // Followed by one std::uint64_t offset per column.
+        struct column_header {
+            std::array<char, 8> magic;
+            std::uint64_t schema;
+            std::uint64_t rows;
+            std::uint64_t stride;
+            std::uint32_t columns;
+            std::uint32_t data; // offset of the first column block
+        };
+
+        constexpr std::uint64_t column_round(std::uint64_t n) noexcept {
+            return (n + column_align - 1) / column_align * column_align;
+        }
+
+        template <typename... Fs>
+        consteval std::uint64_t column_schema_hash() {
+            std::uint64_t h = 0xcbf29ce484222325ull; // FNV-1a over the words below
+            const auto mix  = [&h](std::uint64_t w) {
+                for (int b = 0; b < 8; ++b, w >>= 8)
+                    h = (h ^ (w & 0xff)) * 0x100000001b3ull;
+            };
+            mix(std::endian::native == std::endian::little);
+            (mix(stable_type_id_v<Fs>), ...);
+            (mix(sizeof(Fs) << 8 | alignof(Fs)), ...);
+            return h;
+        }
+
+    } // namespace detail
+    /// @endcond
+
+    /**
+     * @brief Writer and read-only mapped reader of the columnar file of @p Schema.
+     * @tparam Schema `detail::HTList<Fs...>` of distinct, trivially copyable field types.
+     */
+    template <typename Schema>
+    class column_file;
+
+    template <typename... Fs>
+    class column_file<detail::HTList<Fs...>> {
+        using list = detail::HTList<Fs...>;
+
+        static_assert(sizeof...(Fs) > 0, "column_file: schema has no fields");
+        static_assert(((detail::count_of_v<Fs, list> == 1) && ...), "column_file: field types must be distinct");
+        static_assert((std::is_trivially_copyable_v<Fs> && ...), "column_file: fields must be trivially copyable");
+        static_assert(((alignof(Fs) <= detail::column_align) && ...), "column_file: fields may be at most 64-byte aligned");
+
+    public:
+        /// @brief Number of columns.
+        static constexpr std::size_t columns = sizeof...(Fs);
+
+        /// @brief Hash stored in the header and checked by @ref open.
+        static constexpr std::uint64_t schema_hash = detail::column_schema_hash<Fs...>();
+
+        /// @brief Bytes per row, summed over the columns.
+        static constexpr std::size_t row_bytes = Sum_v<SizeOf<Fs>...>;
+
+        /// @brief Offset of column `i` within a block of rows, per row.
+        static constexpr auto row_offsets = exclusive_scan_v<SizeOf, Fs...>;
+
+        /// @brief Size of the header block: header, column offsets, padding.
+        static constexpr std::size_t header_bytes
+            = detail::column_round(sizeof(detail::column_header) + columns * sizeof(std::uint64_t));
+
+        /// @brief Elements stored per column for @p rows rows: @p rows rounded up to 64.
+        static constexpr std::uint64_t stride(std::uint64_t rows) noexcept { return detail::column_round(rows); }
+
+        /// @brief Byte offset of column @p i in a file of @p rows rows; a multiple of 64.
+        static constexpr std::uint64_t column_offset(std::size_t i, std::uint64_t rows) noexcept {
+            return header_bytes + stride(rows) * row_offsets[i];
+        }
+
+        /// @brief Size of a file of @p rows rows.
+        static constexpr std::uint64_t file_size(std::uint64_t rows) noexcept {
+            return header_bytes + stride(rows) * row_bytes;
+        }
+
+        /**
+         * @brief Write @p cols, one span per field in schema order, to @p path.
+         * @details Every span must have the same length. The file is written to
+         *          `path + ".tmp"`, flushed to disk and renamed over @p path, so a crash
+         *          leaves the old snapshot intact and processes that still map it keep
+         *          reading the old contents.
+         */
+        static column_file_error write(const char* path, std::span<const Fs>... cols) {
+            const std::array<std::size_t, columns> lengths{cols.size()...};
+            const std::uint64_t rows = lengths[0];
+            for (std::size_t n : lengths)
+                if (n != rows)
+                    return column_file_error::ragged_columns;
+
+            std::array<std::byte, header_bytes> head{};
+            const detail::column_header h{detail::column_magic, schema_hash, rows, stride(rows),
+                                          static_cast<std::uint32_t>(columns), static_cast<std::uint32_t>(header_bytes)};
+            std::memcpy(head.data(), &h, sizeof h);
+            for (std::size_t i = 0; i < columns; ++i) {
+                const std::uint64_t at = column_offset(i, rows);
+                std::memcpy(head.data() + sizeof h + i * sizeof at, &at, sizeof at);
+            }
+
+            const std::string tmp = std::string(path) + ".tmp";
+            std::FILE* f          = std::fopen(tmp.c_str(), "wb");
+            if (f == nullptr)
+                return column_file_error::open_failed;
+            bool ok = std::fwrite(head.data(), 1, head.size(), f) == head.size();
+            ((ok = ok && write_block(f, cols, rows)), ...);
+            ok = ok && std::fflush(f) == 0 && ::fsync(::fileno(f)) == 0;
+            ok = std::fclose(f) == 0 && ok;
+            ok = ok && std::rename(tmp.c_str(), path) == 0;
+            if (!ok)
+                std::remove(tmp.c_str());
+            return ok ? column_file_error::none : column_file_error::io_failed;
+        }
+
+        column_file() = default;
+
+        column_file(column_file&& o) noexcept
+            : base_(std::exchange(o.base_, nullptr))
+            , bytes_(std::exchange(o.bytes_, 0))
+            , rows_(std::exchange(o.rows_, 0)) { }
+
+        column_file& operator=(column_file&& o) noexcept {
+            if (this != &o) {
+                close();
+                base_  = std::exchange(o.base_, nullptr);
+                bytes_ = std::exchange(o.bytes_, 0);
+                rows_  = std::exchange(o.rows_, 0);
+            }
+            return *this;
+        }
+
+        ~column_file() { close(); }
+
+        /// @brief Map @p path read-only and validate its header; closes any file mapped before.
+        column_file_error open(const char* path) {
+            close();
+            const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+                return column_file_error::open_failed;
+            struct stat st;
+            if (::fstat(fd, &st) != 0) {
+                ::close(fd);
+                return column_file_error::io_failed;
+            }
+            const auto size = static_cast<std::uint64_t>(st.st_size);
+            if (size < header_bytes) {
+                ::close(fd);
+                return column_file_error::bad_header;
+            }
+            void* p = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+            ::close(fd); // the mapping keeps the file open
+            if (p == MAP_FAILED)
+                return column_file_error::io_failed;
+
+            const column_file_error e = check(static_cast<const std::byte*>(p), size);
+            if (e != column_file_error::none) {
+                ::munmap(p, size);
+                return e;
+            }
+            base_  = static_cast<const std::byte*>(p);
+            bytes_ = size;
+            std::uint64_t rows;
+            std::memcpy(&rows, base_ + offsetof(detail::column_header, rows), sizeof rows);
+            rows_ = static_cast<std::size_t>(rows);
+            return column_file_error::none;
+        }
+
+        /// @brief Unmap the file; spans handed out before become dangling.
+        void close() noexcept {
+            if (base_ != nullptr)
+                ::munmap(const_cast<std::byte*>(base_), bytes_);
+            base_  = nullptr;
+            bytes_ = 0;
+            rows_  = 0;
+        }
+
+        /// @brief `true` while a file is mapped.
+        bool is_open() const noexcept { return base_ != nullptr; }
+
+        /// @brief Number of rows; 0 when closed.
+        std::size_t rows() const noexcept { return rows_; }
+
+        /// @brief Column @p I, mapped in place; empty when closed.
+        template <std::size_t I>
+            requires(I < columns)
+        std::span<const detail::type_at_t<I, list>> column() const noexcept {
+            using F = detail::type_at_t<I, list>;
+            if (base_ == nullptr)
+                return {};
+            return {std::launder(reinterpret_cast<const F*>(base_ + column_offset(I, rows_))), rows_};
+        }
+
+        /// @brief The column of field @p F, mapped in place; empty when closed.
+        template <typename F>
+            requires(detail::count_of_v<F, list> == 1)
+        std::span<const F> column() const noexcept {
+            return column<detail::index_of_v<F, list>>();
+        }
+
+    private:
+        template <typename F>
+        static bool write_block(std::FILE* f, std::span<const F> col, std::uint64_t rows) {
+            static constexpr std::byte zeros[4096]{};
+            if (std::fwrite(col.data(), sizeof(F), col.size(), f) != col.size())
+                return false;
+            for (std::uint64_t pad = (stride(rows) - rows) * sizeof(F); pad != 0;) {
+                const std::size_t n = pad < sizeof zeros ? static_cast<std::size_t>(pad) : sizeof zeros;
+                if (std::fwrite(zeros, 1, n, f) != n)
+                    return false;
+                pad -= n;
+            }
+            return true;
+        }
+
+        static column_file_error check(const std::byte* p, std::uint64_t size) noexcept {
+            detail::column_header h;
+            std::memcpy(&h, p, sizeof h);
+            if (h.magic != detail::column_magic)
+                return column_file_error::bad_header;
+            if (h.schema != schema_hash || h.columns != columns)
+                return column_file_error::schema_mismatch;
+            if (h.rows > (size - header_bytes) / row_bytes || file_size(h.rows) > size)
+                return column_file_error::truncated;
+            if (h.data != header_bytes || h.stride != stride(h.rows))
+                return column_file_error::bad_header;
+            for (std::size_t i = 0; i < columns; ++i) {
+                std::uint64_t at;
+                std::memcpy(&at, p + sizeof h + i * sizeof at, sizeof at);
+                if (at != column_offset(i, h.rows))
+                    return column_file_error::bad_header;
+            }
+            return column_file_error::none;
+        }
+
+        const std::byte* base_ = nullptr;
+        std::uint64_t bytes_   = 0;
+        std::size_t rows_      = 0;
+    };
+
+} // namespace ctql
+
+#endif
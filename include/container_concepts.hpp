@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <complex>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/// @file
+/// @brief Concepts recognising standard containers (`is_vector`, `is_map`, `is_tuple`, ...).
+/// @details Opt-in: pulls in `<map>`, `<set>`, `<complex>`, ... and is therefore not
+/// part of `ctql/core.hpp`.
+
+namespace ctql {
+    template <typename T>
+    concept is_bits_array
+        = std::is_trivially_copyable_v<typename T::value_type> && std::is_trivially_copyable_v<T>;
+
+    /// @concept is std::complex
+    template <typename T>
+    concept is_complex = requires(T t) {
+        typename T::value_type;
+        std::is_same_v<T, std::complex<typename T::value_type>>;
+    };
+
+    /// @concept is std::vector
+    template <typename T>
+    concept is_vector = requires(T t) {
+        typename T::value_type;
+        std::is_same_v<T, std::vector<typename T::value_type>>;
+    };
+
+    /// @concept is map
+    template <typename T>
+    concept is_map = requires(T t) {
+        typename T::key_type;
+        typename T::mapped_type;
+        std::is_same_v<T, std::map<typename T::key_type, typename T::mapped_Type>>
+            or std::is_same_v<T, std::unordered_map<typename T::key_type, typename T::mapped_Type>>
+            or std::is_same_v<T, std::multimap<typename T::key_type, typename T::mapped_Type>>;
+    };
+
+    /// @concept is std::set
+    template <typename T>
+    concept is_set = requires(T t) {
+        typename T::value_type;
+        std::is_same_v<T, std::set<typename T::value_type>>;
+    };
+
+    /// @concept is pair
+    template <typename T>
+    concept is_pair = requires(T) {
+        std::is_same_v<T, std::pair<typename T::first_type, typename T::second_type>>;
+    };
+
+    /// @concept is tuple
+    namespace detail {
+        template <typename T, uint64_t... Ns>
+        constexpr bool is_tuple_aux(std::index_sequence<Ns...>) {
+            return std::is_same_v<T, std::tuple<std::tuple_element_t<Ns, T>...>>;
+        }
+    } // namespace detail
+
+    template <typename T>
+    struct is_std_array : std::false_type { };
+
+    template <typename T, std::size_t N>
+    struct is_std_array<std::array<T, N>> : std::true_type { };
+
+    template <typename T>
+    concept is_array = requires(T t) {
+        typename T::value_type;
+        std::is_same_v<T, std::array<typename T::value_type, std::tuple_size<T>::value>>;
+    };
+
+    template <typename T>
+    concept is_tuple
+        = detail::is_tuple_aux<T>(std::make_index_sequence<std::tuple_size<T>::value>());
+} // namespace ctql
@@ -2,15 +2,15 @@
 
 #include <array>
 #include <cstddef>
-#include <functional> // std::invoke
-#include <string_view>
-#include <utility>    // std::move, std::index_sequence_for
+#include <type_traits>
+#include <utility> // std::move, std::index_sequence_for
 
 /// @file
 /// @brief Compile-time string utilities and small metaprogramming helpers.
 /// @details
 /// Provides a fixed-size `ct_string<N>` that can be constructed at compile time,
-/// concatenated, compared, and converted to `std::string_view`. Also includes:
+/// concatenated, compared, and converted to any view constructible from
+/// `(const char*, std::size_t)` such as `std::string_view`. Also includes:
 /// - a consteval `to_ct_string<N>()` that renders an integer template arg to a `ct_string`,
 /// - a user-defined literal `"_ct"` that turns a string literal into a `ct_string`,
 /// - an overload set combiner `match{...}` for pattern-style visitation,
@@ -48,7 +48,18 @@ namespace ctql {
         constexpr std::size_t size() const { return N; }
 
         /// @brief Implicit view of the first `N` characters (excludes the terminator).
-        constexpr operator std::string_view() const { return {data.data(), N}; }
+        /// @details `View` is `std::string_view` (or another non-owning, trivially copyable
+        ///          view with a `traits_type`). A template so that `<string_view>` is not
+        ///          required; owning strings and spans are not implicit targets, so an
+        ///          overload set such as `f(std::string_view)` / `f(std::string)` stays
+        ///          unambiguous.
+        template <typename View>
+            requires std::is_trivially_copyable_v<View> && requires { typename View::traits_type; }
+                     && std::is_same_v<typename View::value_type, char>
+                     && std::is_constructible_v<View, const char*, std::size_t>
+        constexpr operator View() const {
+            return View(data.data(), N);
+        }
     };
 
     /// @brief Deduction guide: `ct_string("abc")` becomes `ct_string<3>`.
@@ -145,8 +156,12 @@ namespace ctql {
 
     /**
      * @brief Convenience macro to invoke a `match{...}` on a value.
+     * @details Also provided by the `CTQL_ENABLE_DSL` layer of macros.hpp; whichever
+     *          header comes first defines it.
      */
-#define $match(arg, ...) std::invoke(ctql::match{__VA_ARGS__}, arg)
+#ifndef $match
+#  define $match(arg, ...) ctql::match{__VA_ARGS__}(arg)
+#endif
 
     /**
      * @brief Invoke `fn.template operator()<T, I>()` for each `T` in `Ts...`
@@ -0,0 +1,211 @@
+#pragma once
+
+#include "function_traits.hpp"
+#include "htlist.hpp"
+#include "serialize.hpp"
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+/// @file
+/// @brief Message dispatcher built from the handlers' signatures.
+/// @details
+/// `make_dispatcher(handlers...)` reads the first parameter type of every handler
+/// (through @ref function_traits), collects them into `messages`, checks that no
+/// message has two handlers and that no two messages share an id, and builds a
+/// dense table indexed by `message_id<M>::value - min_id`. An incoming packet
+/// costs one bounds check and one indirect call: no overload resolution and no
+/// id switch at runtime.
+///
+/// ### Example
+///
+/// @code{.cpp}
+/// struct Login { static constexpr std::uint16_t id = 1; std::uint64_t user; };
+/// struct Ping  { static constexpr std::uint16_t id = 2; std::uint32_t seq; };
+///
+/// auto on_packet = ctql::make_dispatcher<ctql::detail::HTList<Login, Ping>>(
+///     [&](const Login& m) { accept(m.user); },
+///     [&](const Ping& m)  { pong(m.seq); });
+///
+/// on_packet.dispatch(hdr.id, body);  // false: unknown id or short payload
+/// on_packet(Ping{7});                // typed call, resolved at compile time
+/// @endcode
+///
+/// A message with a @ref wire_codec is decoded through it, in little-endian order as
+/// `serialize` writes by default; derive the codec from @ref wire_fields to dispatch
+/// packets built with `serialize`. Any other (trivially copyable) message is copied
+/// as its host object image: `sizeof(M)` bytes, padding included, in host byte order.
+///
+/// The table has `max_id - min_id + 1` entries; a span above
+/// `CTQL_DISPATCH_MAX_SPAN` (default 4096) is a compile error, since sparse ids
+/// would fill rodata with empty slots. Use `match_dispatch` for those.
+
+#ifndef CTQL_DISPATCH_MAX_SPAN
+#  define CTQL_DISPATCH_MAX_SPAN 4096
+#endif
+
+namespace ctql {
+
+    /**
+     * @brief Id of message type @p M in the dispatch table.
+     * @details Defaults to `M::id`; specialize for messages that cannot carry one.
+     */
+    template <typename M>
+    struct message_id {
+        static constexpr std::size_t value = static_cast<std::size_t>(M::id);
+    };
+
+    /// @cond INTERNAL
+    namespace detail {
+        // Message type handled by H: its first parameter, without cv/ref.
+        template <typename H>
+        using handled_message_t = std::remove_cvref_t<get_nth_argument_t<H, 0>>;
+
+        template <std::size_t I, typename H>
+        struct handler_slot {
+            H fn;
+        };
+
+        template <typename Seq, typename... Hs>
+        struct handler_set;
+
+        template <std::size_t... Is, typename... Hs>
+        struct handler_set<std::index_sequence<Is...>, Hs...> : handler_slot<Is, Hs>... { };
+
+        template <std::size_t N>
+        consteval bool ids_unique(std::array<std::size_t, N> ids) {
+            for (std::size_t i = 0; i < N; ++i)
+                for (std::size_t j = i + 1; j < N; ++j)
+                    if (ids[i] == ids[j])
+                        return false;
+            return true;
+        }
+
+        // Every message of Expected is handled exactly once and nothing else is handled.
+        template <typename Expected, typename Handled>
+        inline constexpr bool handles_exactly = false;
+
+        template <typename... Es, typename Handled>
+        inline constexpr bool handles_exactly<HTList<Es...>, Handled>
+            = sizeof...(Es) == Handled::len && ((count_of_v<Es, Handled> == 1) && ...);
+    } // namespace detail
+    /// @endcond
+
+    /**
+     * @brief Dense id -> handler table over the handlers @p Hs.
+     * @tparam Hs Handler types; each takes its message as first parameter.
+     *
+     * @details
+     * - `messages`: `detail::HTList` of the handled message types, in handler order.
+     * - `ids`: `message_id<M>::value` per message; `min_id`, `max_id`, `table_size`.
+     */
+    template <typename... Hs>
+    class dispatcher {
+    public:
+        using messages = detail::HTList<detail::handled_message_t<Hs>...>;
+
+        static constexpr std::array<std::size_t, sizeof...(Hs)> ids{
+            message_id<detail::handled_message_t<Hs>>::value...};
+
+        static constexpr std::size_t min_id = [] {
+            std::size_t m = ids[0];
+            for (std::size_t id : ids)
+                m = id < m ? id : m;
+            return m;
+        }();
+
+        static constexpr std::size_t max_id = [] {
+            std::size_t m = ids[0];
+            for (std::size_t id : ids)
+                m = id > m ? id : m;
+            return m;
+        }();
+
+        static constexpr std::size_t table_size = max_id - min_id + 1;
+
+        static_assert(sizeof...(Hs) > 0, "dispatcher: no handlers");
+        static_assert(((detail::count_of_v<detail::handled_message_t<Hs>, messages> == 1) && ...),
+                      "dispatcher: a message type has more than one handler");
+        static_assert(detail::ids_unique(ids), "dispatcher: two message types share an id");
+        static_assert(table_size <= CTQL_DISPATCH_MAX_SPAN,
+                      "dispatcher: ids too sparse for a dense table (raise CTQL_DISPATCH_MAX_SPAN or use match_dispatch)");
+
+        constexpr explicit dispatcher(Hs... hs)
+            : handlers_{{std::move(hs)}...} { }
+
+        /**
+         * @brief Decode @p payload as the message with id @p id and run its handler.
+         * @returns `false` if no handler has @p id or @p payload is too short.
+         */
+        bool dispatch(std::size_t id, std::span<const std::byte> payload) {
+            const std::size_t slot = id - min_id; // wraps for id < min_id
+            if (slot >= table_size)
+                return false;
+            const entry& e = table[slot];
+            if (e.fn == nullptr || payload.size() < e.bytes)
+                return false;
+            e.fn(*this, payload.data());
+            return true;
+        }
+
+        /// @brief Run the handler of `M` directly.
+        template <typename M>
+            requires(detail::count_of_v<M, messages> == 1)
+        constexpr decltype(auto) operator()(const M& m) {
+            return handler<detail::index_of_v<M, messages>>()(m);
+        }
+
+    private:
+        struct entry {
+            void (*fn)(dispatcher&, const std::byte*) = nullptr;
+            std::size_t bytes                         = 0;
+        };
+
+        template <std::size_t I>
+        constexpr auto& handler() {
+            using H = detail::type_at_t<I, detail::HTList<Hs...>>;
+            return static_cast<detail::handler_slot<I, H>&>(handlers_).fn;
+        }
+
+        template <std::size_t I>
+        static void invoke(dispatcher& self, const std::byte* in) {
+            using M = detail::type_at_t<I, messages>;
+            M m;
+            if constexpr (std::is_trivially_copyable_v<M> && !detail::has_wire_codec<M>)
+                std::memcpy(&m, in, sizeof(M));
+            else
+                detail::codec_decode<std::endian::little>(in, m);
+            self.template handler<I>()(m);
+        }
+
+        static constexpr std::array<entry, table_size> table = [] {
+            std::array<entry, table_size> out{};
+            [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                ((out[ids[Is] - min_id]
+                  = entry{&invoke<Is>, detail::wire_size_of<detail::type_at_t<Is, messages>>()}),
+                 ...);
+            }(std::index_sequence_for<Hs...>{});
+            return out;
+        }();
+
+        detail::handler_set<std::index_sequence_for<Hs...>, Hs...> handlers_;
+    };
+
+    /**
+     * @brief Build a @ref dispatcher from handler callables.
+     * @tparam Messages Optional `detail::HTList` of the expected messages. When given,
+     *                  every one of them must have exactly one handler and no other
+     *                  message may be handled.
+     */
+    template <typename Messages = void, typename... Hs>
+    constexpr auto make_dispatcher(Hs&&... hs) {
+        using D = dispatcher<std::decay_t<Hs>...>;
+        static_assert(std::is_void_v<Messages> || detail::handles_exactly<Messages, typename D::messages>,
+                      "make_dispatcher: handlers do not cover the message list exactly once");
+        return D(std::forward<Hs>(hs)...);
+    }
+
+} // namespace ctql
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "htlist.hpp"
+#include <tuple>
+#include <variant>
+
+/// @file
+/// @brief Turn a list of key wrappers into `std::tuple` / `std::variant`.
+/// @details Opt-in: needs `<tuple>` and `<variant>`.
+///
+/// @code{.cpp}
+/// using Sorted = ctql::TypeSort<ctql::Order::Asc, ctql::Size, A, B, C>;
+/// using Tup    = ctql::to_tuple<Sorted>::type; // std::tuple<B, C, A>
+/// using Flat   = ctql::to_tuple<Sorted, ctql::flat_tuple>::type; // ctql::flat_tuple<B, C, A>
+/// @endcode
+
+namespace ctql {
+    // ---------- extraction helpers ----------
+    template <typename>
+    struct to_variant;
+    template <typename... Ms>
+    struct to_variant<detail::HTList<Ms...>> {
+        using type = std::variant<typename Ms::type...>;
+    };
+
+    /// @brief `Target<T...>` of the wrapped types; `Target` may be e.g. `ctql::flat_tuple`.
+    template <typename, template <typename...> class Target = std::tuple>
+    struct to_tuple;
+    template <typename... Ms, template <typename...> class Target>
+    struct to_tuple<detail::HTList<Ms...>, Target> {
+        using type = Target<typename Ms::type...>;
+    };
+} // namespace ctql
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+/// @file
+/// @brief A tuple built by multiple inheritance from one leaf per element.
+/// @details
+/// libstdc++'s `std::tuple<Ts...>` nests one base per element, so it instantiates
+/// `sizeof...(Ts)` levels of templates and is never trivially copyable.
+/// `flat_tuple<Ts...>` derives from `flat_leaf<I, T>` for every element at once:
+///
+/// - `get<I>` and `get<T>` are one derived-to-base cast, picked by overload
+///   resolution; no recursion at any size;
+/// - copy, move and destruction are the implicit ones, so a tuple of trivially
+///   copyable types is trivially copyable and can be `memcpy`'d;
+/// - members sit in element order. With zero or one element the tuple is also
+///   standard-layout (several bases with members never are);
+/// - `std::tuple_size` / `std::tuple_element` and an ADL `get` make structured
+///   bindings work; `flat_apply` stands in for `std::apply`.
+///
+/// `to_tuple<List, flat_tuple>` builds one from a key list.
+///
+/// ### Example
+///
+/// @code{.cpp}
+/// ctql::flat_tuple<std::uint32_t, double, char> row{7u, 1.5, 'B'};
+/// static_assert(std::is_trivially_copyable_v<decltype(row)>);
+///
+/// auto& [qty, px, side] = row;
+/// ctql::get<double>(row) *= 2;
+/// @endcode
+
+namespace ctql {
+
+    /// @cond INTERNAL
+    namespace detail {
+
+        template <std::size_t I, typename T>
+        struct flat_leaf {
+            T value;
+
+            constexpr bool operator==(const flat_leaf&) const = default;
+        };
+
+        template <typename Seq, typename... Ts>
+        struct flat_base;
+
+        template <std::size_t... Is, typename... Ts>
+        struct flat_base<std::index_sequence<Is...>, Ts...> : flat_leaf<Is, Ts>... {
+            constexpr flat_base() = default;
+
+            template <typename... Us>
+            constexpr explicit flat_base(std::in_place_t, Us&&... us)
+                : flat_leaf<Is, Ts>(std::forward<Us>(us))... { }
+
+            constexpr bool operator==(const flat_base&) const = default;
+        };
+
+        // Deduce the leaf of index I (or of type T) from the derived-to-base conversion.
+        template <std::size_t I, typename T>
+        constexpr flat_leaf<I, T>& leaf_at(flat_leaf<I, T>& l) noexcept {
+            return l;
+        }
+        template <std::size_t I, typename T>
+        constexpr const flat_leaf<I, T>& leaf_at(const flat_leaf<I, T>& l) noexcept {
+            return l;
+        }
+        template <typename T, std::size_t I>
+        constexpr flat_leaf<I, T>& leaf_of(flat_leaf<I, T>& l) noexcept {
+            return l;
+        }
+        template <typename T, std::size_t I>
+        constexpr const flat_leaf<I, T>& leaf_of(const flat_leaf<I, T>& l) noexcept {
+            return l;
+        }
+
+    } // namespace detail
+    /// @endcond
+
+    /**
+     * @brief Tuple of @p Ts stored as sibling bases; trivially copyable when every `T` is.
+     */
+    template <typename... Ts>
+    struct flat_tuple : detail::flat_base<std::index_sequence_for<Ts...>, Ts...> {
+    private:
+        using base = detail::flat_base<std::index_sequence_for<Ts...>, Ts...>;
+
+    public:
+        /// @brief Default-initializes the elements; `flat_tuple<...> t{}` zeroes scalars.
+        constexpr flat_tuple() = default;
+
+        /// @brief Construct element `I` from `us[I]`.
+        template <typename... Us>
+            requires(sizeof...(Us) == sizeof...(Ts) && sizeof...(Ts) > 0 && (std::is_constructible_v<Ts, Us> && ...)
+                     && !(sizeof...(Ts) == 1 && (std::is_same_v<std::remove_cvref_t<Us>, flat_tuple> || ...)))
+        constexpr flat_tuple(Us&&... us)
+            : base(std::in_place, std::forward<Us>(us)...) { }
+
+        constexpr bool operator==(const flat_tuple&) const = default;
+    };
+
+    template <typename... Ts>
+    flat_tuple(Ts...) -> flat_tuple<Ts...>;
+
+    /// @brief Element @p I of @p t.
+    template <std::size_t I, typename... Ts>
+    constexpr auto& get(flat_tuple<Ts...>& t) noexcept {
+        return detail::leaf_at<I>(t).value;
+    }
+    template <std::size_t I, typename... Ts>
+    constexpr const auto& get(const flat_tuple<Ts...>& t) noexcept {
+        return detail::leaf_at<I>(t).value;
+    }
+    template <std::size_t I, typename... Ts>
+    constexpr auto&& get(flat_tuple<Ts...>&& t) noexcept {
+        using T = decltype(detail::leaf_at<I>(t).value);
+        return std::forward<T>(detail::leaf_at<I>(t).value);
+    }
+
+    /// @brief The element of type @p T of @p t; ill-formed unless `T` occurs exactly once.
+    template <typename T, typename... Ts>
+    constexpr T& get(flat_tuple<Ts...>& t) noexcept {
+        return detail::leaf_of<T>(t).value;
+    }
+    template <typename T, typename... Ts>
+    constexpr const T& get(const flat_tuple<Ts...>& t) noexcept {
+        return detail::leaf_of<T>(t).value;
+    }
+    template <typename T, typename... Ts>
+    constexpr T&& get(flat_tuple<Ts...>&& t) noexcept {
+        return std::forward<T>(detail::leaf_of<T>(t).value);
+    }
+
+    /// @brief `fn(get<0>(t), get<1>(t), ...)`, as `std::apply` for `std::tuple`.
+    template <typename F, typename Tuple>
+        requires requires { std::tuple_size<std::remove_cvref_t<Tuple>>::value; }
+    constexpr decltype(auto) flat_apply(F&& fn, Tuple&& t) {
+        return [&]<std::size_t... Is>(std::index_sequence<Is...>) -> decltype(auto) {
+            return std::forward<F>(fn)(get<Is>(std::forward<Tuple>(t))...);
+        }(std::make_index_sequence<std::tuple_size_v<std::remove_cvref_t<Tuple>>>{});
+    }
+
+} // namespace ctql
+
+template <typename... Ts>
+struct std::tuple_size<ctql::flat_tuple<Ts...>> : std::integral_constant<std::size_t, sizeof...(Ts)> { };
+
+template <std::size_t I, typename... Ts>
+struct std::tuple_element<I, ctql::flat_tuple<Ts...>> {
+    using type = decltype(ctql::detail::leaf_at<I>(std::declval<ctql::flat_tuple<Ts...>&>()).value);
+};
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "htlist.hpp"
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+
+/// @file
+/// @brief Function signature introspection (`function_traits`, `is_function_with_signature`).
+/// @details
+/// `function_traits<T>` accepts function types, function pointers and references,
+/// pointers to member functions (any cv / ref qualifier) and callable objects with
+/// a single non-template `operator()` such as lambdas. `noexcept` is kept in
+/// `is_noexcept` and dropped from `as_c_function`. Nothing is instantiated beyond
+/// the traits themselves; in particular no `std::function`.
+///
+/// @code{.cpp}
+/// auto on_tick = [](int, double) noexcept { return 1L; };
+/// using T = ctql::function_traits<decltype(on_tick)>;
+/// static_assert(std::is_same_v<T::as_c_function, long(int, double)> && T::is_noexcept);
+/// static_assert(std::is_same_v<T::argument_type<1>, double>);
+/// @endcode
+///
+/// Opt-in: not part of `ctql/core.hpp`.
+
+namespace ctql {
+    /// @brief introspect functions
+    template <typename T>
+    struct function_traits;
+
+    template <typename Return_t, typename... Args_t, bool Noexcept>
+    struct function_traits<Return_t(Args_t...) noexcept(Noexcept)> {
+        // as C literal function
+        using as_c_function = Return_t(Args_t...);
+
+        // as a type-erased wrapper, e.g. `as<std::function>`
+        template <template <typename> class Wrapper>
+        using as = Wrapper<Return_t(Args_t...)>;
+
+        // return type
+        using return_t = Return_t;
+
+        // whether the call is noexcept
+        static constexpr bool is_noexcept = Noexcept;
+
+        // number of arguments
+        static constexpr uint64_t n_args = sizeof...(Args_t);
+
+        // all argument types as typelist / tuple type
+        using arguments   = detail::HTList<Args_t...>;
+        using argument_ts = std::tuple<Args_t...>;
+
+        // type of i-th argument
+        template <uint64_t i>
+        using argument_type = detail::type_at_t<i, arguments>;
+    };
+
+    // Cv- and ref-qualified function types, as found behind member function pointers.
+#define CTQL_FUNCTION_TRAITS_QUALIFIED(QUALS)                                                        \
+    template <typename Return_t, typename... Args_t, bool Noexcept>                                  \
+    struct function_traits<Return_t(Args_t...) QUALS noexcept(Noexcept)>                             \
+        : function_traits<Return_t(Args_t...) noexcept(Noexcept)> { };
+
+    CTQL_FUNCTION_TRAITS_QUALIFIED(const)
+    CTQL_FUNCTION_TRAITS_QUALIFIED(volatile)
+    CTQL_FUNCTION_TRAITS_QUALIFIED(const volatile)
+    CTQL_FUNCTION_TRAITS_QUALIFIED(&)
+    CTQL_FUNCTION_TRAITS_QUALIFIED(const&)
+    CTQL_FUNCTION_TRAITS_QUALIFIED(volatile&)
+    CTQL_FUNCTION_TRAITS_QUALIFIED(const volatile&)
+    CTQL_FUNCTION_TRAITS_QUALIFIED(&&)
+    CTQL_FUNCTION_TRAITS_QUALIFIED(const&&)
+    CTQL_FUNCTION_TRAITS_QUALIFIED(volatile&&)
+    CTQL_FUNCTION_TRAITS_QUALIFIED(const volatile&&)
+#undef CTQL_FUNCTION_TRAITS_QUALIFIED
+
+    // function pointers and references
+    template <typename Return_t, typename... Args_t, bool Noexcept>
+    struct function_traits<Return_t (*)(Args_t...) noexcept(Noexcept)>
+        : function_traits<Return_t(Args_t...) noexcept(Noexcept)> { };
+
+    template <typename Return_t, typename... Args_t, bool Noexcept>
+    struct function_traits<Return_t (&)(Args_t...) noexcept(Noexcept)>
+        : function_traits<Return_t(Args_t...) noexcept(Noexcept)> { };
+
+    // pointers to member functions; the object is not part of the arguments
+    template <typename Fn, typename Class_t>
+        requires std::is_function_v<Fn>
+    struct function_traits<Fn Class_t::*> : function_traits<Fn> {
+        using class_type = Class_t;
+    };
+
+    // callable objects (lambdas, functors) with a single operator()
+    template <typename T>
+        requires requires { &std::remove_cvref_t<T>::operator(); }
+    struct function_traits<T> : function_traits<decltype(&std::remove_cvref_t<T>::operator())> { };
+
+    template <typename T, uint64_t i>
+    using get_nth_argument_t = typename function_traits<T>::template argument_type<i>;
+
+    /// @brief forward function or lambda as C-literal function
+    namespace detail {
+        template <typename T>
+        struct as_c_function {
+            using value = typename function_traits<T>::as_c_function;
+        };
+
+        template <typename T>
+        using as_c_function_v = typename as_c_function<T>::value;
+    } // namespace detail
+
+    /// @concept: check signature of argument function or lambda
+    template <typename T, typename Return_t, typename... Args_t>
+    concept is_function_with_signature
+        = std::is_invocable_v<detail::as_c_function_v<T>, Args_t...>
+          and std::conditional_t<
+              std::is_void_v<Return_t>,
+              std::is_void<typename function_traits<detail::as_c_function_v<T>>::return_t>,
+              std::is_same<
+                  typename function_traits<detail::as_c_function_v<T>>::return_t,
+                  Return_t>>::value;
+} // namespace ctql
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "htlist.hpp"
+#include "layout.hpp"
+#include "partition.hpp"
+#include "predicates.hpp"
+#include <bit>
+#include <cstddef>
+
+/// @file
+/// @brief Hot/cold splitting of a field list by a per-field hotness key.
+/// @details
+/// `hot_cold_split<Fields, HotKey, Threshold>` partitions a field list with
+/// `partition_by_key` on `HotKey<F>::size >= Threshold`. Hot fields are packed
+/// (decreasing alignment, see `align_sorted_t`) into `hot_type`, together with a
+/// pointer to the cold block; cold fields go into `cold_type`. `get<F>()` hides
+/// which side a field lives on.
+///
+/// `hot_type` is aligned so that it never straddles more cache lines than its
+/// size requires; `hot_lines` reports how many it occupies.
+///
+/// ### Example
+///
+/// @code{.cpp}
+/// template <class F> struct Hotness { using type = F; static constexpr std::size_t size = F::hotness; };
+///
+/// using Entry = ctql::hot_cold_split<ctql::detail::HTList<Price, Qty, Owner, Created>, Hotness, 50>;
+///
+/// Entry::cold_type cold{};
+/// Entry::hot_type  hot{};
+/// hot.link(cold);
+/// hot.get<Price>().v = 10;          // stored in hot
+/// hot.get<Owner>().id = 7;          // forwarded through the cold pointer
+/// static_assert(Entry::hot_lines == 1);
+/// @endcode
+///
+/// For parallel arrays (`hot_type[]` next to `cold_type[]` at the same index),
+/// use the static `Entry::get<F>(hot, cold)` overload instead of the pointer.
+
+namespace ctql {
+
+    /// @brief Cache line size used for hot-block alignment.
+    inline constexpr std::size_t cache_line_size = 64;
+
+    template <typename Fields,
+              template <typename> class HotKey,
+              std::size_t Threshold,
+              std::size_t Line = cache_line_size>
+    struct hot_cold_split;
+
+    /**
+     * @brief Split @p Fields into a packed hot block and an out-of-line cold block.
+     * @tparam Fields    `detail::HTList<Fs...>` of distinct field types.
+     * @tparam HotKey    Key wrapper; `HotKey<F>::size` is the field's hotness.
+     * @tparam Threshold Fields with hotness `>= Threshold` are hot.
+     * @tparam Line      Cache line size in bytes.
+     */
+    template <typename... Fs, template <typename> class HotKey, std::size_t Threshold, std::size_t Line>
+    struct hot_cold_split<detail::HTList<Fs...>, HotKey, Threshold, Line> {
+    private:
+        using split = partition_by_key<SizeConst<Threshold>, ops::geq::template pred, HotKey, Fs...>;
+
+        template <typename List>
+        struct sorted;
+
+        template <typename... Ks>
+        struct sorted<detail::HTList<Ks...>> {
+            using type = align_sorted_t<typename Ks::type...>;
+        };
+
+    public:
+        /// @brief Hot fields, in layout order.
+        using hot_fields = typename sorted<typename split::pass>::type;
+        /// @brief Cold fields, in layout order.
+        using cold_fields = typename sorted<typename split::fail>::type;
+
+        /// @brief Out-of-line block holding the cold fields.
+        struct cold_type : field_block<cold_fields> { };
+
+    private:
+        struct cold_link {
+            cold_type* ptr;
+        };
+
+        template <typename List>
+        struct hot_order;
+
+        template <typename... Hs>
+        struct hot_order<detail::HTList<Hs...>> {
+            using type = align_sorted_t<Hs..., cold_link>;
+        };
+
+        using hot_block = field_block<typename hot_order<hot_fields>::type>;
+
+        // Align to the smallest power of two covering the block (capped at a line),
+        // so a block never spans more lines than its size needs.
+        static constexpr std::size_t hot_align
+            = std::bit_ceil(sizeof(hot_block)) < Line ? std::bit_ceil(sizeof(hot_block)) : Line;
+
+    public:
+        /// @brief Inline block holding the hot fields and the cold pointer.
+        struct alignas(hot_align) hot_type : hot_block {
+            /// @brief Point this entry at its cold block.
+            constexpr void link(cold_type& cold) noexcept { hot_block::template get<cold_link>().ptr = &cold; }
+
+            /// @brief Access field @p F, hot or cold.
+            template <typename F>
+            constexpr F& get() noexcept {
+                if constexpr (hot_block::template contains<F>)
+                    return hot_block::template get<F>();
+                else
+                    return hot_block::template get<cold_link>().ptr->template get<F>();
+            }
+
+            /// @brief Access field @p F, hot or cold.
+            template <typename F>
+            constexpr const F& get() const noexcept {
+                if constexpr (hot_block::template contains<F>)
+                    return hot_block::template get<F>();
+                else
+                    return hot_block::template get<cold_link>().ptr->template get<F>();
+            }
+        };
+
+        /// @brief Number of cache lines one `hot_type` occupies.
+        static constexpr std::size_t hot_lines = (sizeof(hot_type) + Line - 1) / Line;
+
+        /// @brief Access field @p F for parallel `hot_type` / `cold_type` arrays.
+        template <typename F>
+        static constexpr F& get(hot_type& hot, cold_type& cold) noexcept {
+            if constexpr (hot_block::template contains<F>)
+                return hot.template get<F>();
+            else
+                return cold.template get<F>();
+        }
+    };
+
+} // namespace ctql
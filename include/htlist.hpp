@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstddef>
+#include <type_traits>
+#include <utility>
 namespace ctql {
         /// @concept: heterogeneous type list
     namespace detail {
@@ -32,5 +34,74 @@ namespace ctql {
 
         template <typename... T>
         HTList(T...) -> HTList<T...>;
+
+        // type_at<I, HTList<Ts...>>: I-th element in O(1) instantiation depth.
+        // Every element becomes an indexed<I, T> base of one indexer; overload
+        // resolution against indexed<I, *> then picks the element directly.
+        template <std::size_t I, typename T>
+        struct indexed {
+            using type = T;
+        };
+
+        template <typename Seq, typename... Ts>
+        struct indexer;
+
+        template <std::size_t... Is, typename... Ts>
+        struct indexer<std::index_sequence<Is...>, Ts...> : indexed<Is, Ts>... { };
+
+        template <std::size_t I, typename T>
+        indexed<I, T> select_indexed(const indexed<I, T>&);
+
+        template <std::size_t I, typename List>
+        struct type_at;
+
+        template <std::size_t I, typename... Ts>
+        struct type_at<I, HTList<Ts...>> {
+            static_assert(I < sizeof...(Ts), "type_at: index out of range");
+            using type = typename decltype(select_indexed<I>(
+                indexer<std::index_sequence_for<Ts...>, Ts...>{}))::type;
+        };
+
+        template <std::size_t I, typename List>
+        using type_at_t = typename type_at<I, List>::type;
+
+        // index_of<T, HTList<Ts...>>: position of the first T, in one instantiation.
+        template <typename T, typename List>
+        struct index_of;
+
+        template <typename T, typename... Ts>
+        struct index_of<T, HTList<Ts...>> {
+            static constexpr std::size_t value = [] {
+                constexpr bool hit[] = {std::is_same_v<T, Ts>..., false};
+                std::size_t i = 0;
+                while (i < sizeof...(Ts) && !hit[i])
+                    ++i;
+                return i;
+            }();
+            static_assert(value < sizeof...(Ts), "index_of: type not in list");
+        };
+
+        template <typename T, typename List>
+        inline constexpr std::size_t index_of_v = index_of<T, List>::value;
+
+        // count_of<T, HTList<Ts...>>: number of occurrences of T.
+        template <typename T, typename List>
+        inline constexpr std::size_t count_of_v = 0;
+
+        template <typename T, typename... Ts>
+        inline constexpr std::size_t count_of_v<T, HTList<Ts...>> = (std::size_t{std::is_same_v<T, Ts>} + ... + 0);
+
+        // unwrap<HTList<KeyOf<Ts>...>> -> HTList<Ts...>: project key wrappers back
+        // to the types they describe.
+        template <typename List>
+        struct unwrap;
+
+        template <typename... Ks>
+        struct unwrap<HTList<Ks...>> {
+            using type = HTList<typename Ks::type...>;
+        };
+
+        template <typename List>
+        using unwrap_t = typename unwrap<List>::type;
     } // namespace detail
 }
\ No newline at end of file
@@ -0,0 +1,194 @@
+#pragma once
+
+#include "predicates.hpp"
+#include "reduce.hpp"
+#include <cstddef>
+#include <exception>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/// @file
+/// @brief Type-erased callable with inline storage that never allocates.
+/// @details
+/// `inplace_function<R(Args...), Capacity, Align>` stores any copyable callable of
+/// at most `Capacity` bytes and alignment `Align` in an inline buffer. A callable
+/// that does not fit is a compile error, not a heap allocation. A call is one
+/// indirect call through a static per-type table, which the optimizer can inline
+/// once the target is known.
+///
+/// Size the buffer for the callables that will be stored with
+/// `inplace_capacity_v` (the `Max` of `SizeOf` over them), or use
+/// `inplace_function_for<Sig, Fs...>` directly:
+///
+/// @code{.cpp}
+/// auto on_quote = [book = &book](const Quote& q) { book->apply(q); };
+/// auto on_trade = [&log, id = 7u](const Quote& q) { log.write(id, q); };
+///
+/// using Callback = ctql::inplace_function_for<void(const Quote&), decltype(on_quote), decltype(on_trade)>;
+/// std::vector<Callback> subscribers{on_quote, on_trade};
+/// @endcode
+///
+/// Calling an empty `inplace_function` calls `std::terminate`.
+
+namespace ctql {
+
+    /// @brief Default inline capacity: four pointers.
+    inline constexpr std::size_t inplace_function_capacity = 4 * sizeof(void*);
+
+    template <typename Sig,
+              std::size_t Capacity = inplace_function_capacity,
+              std::size_t Align    = alignof(std::max_align_t)>
+    class inplace_function;
+
+    /// @brief Smallest `inplace_function` capacity that fits every callable @p Fs.
+    template <typename... Fs>
+    inline constexpr std::size_t inplace_capacity_v = Max_v<SizeConst<1>, SizeOf<Fs>...>;
+
+    /// @brief Smallest `inplace_function` alignment that fits every callable @p Fs.
+    template <typename... Fs>
+    inline constexpr std::size_t inplace_align_v = Max_v<SizeConst<1>, AlignOf<Fs>...>;
+
+    /// @brief `inplace_function` sized and aligned for exactly the callables @p Fs.
+    template <typename Sig, typename... Fs>
+    using inplace_function_for = inplace_function<Sig, inplace_capacity_v<Fs...>, inplace_align_v<Fs...>>;
+
+    /// @cond INTERNAL
+    namespace detail {
+        template <typename T>
+        inline constexpr bool is_inplace_function = false;
+
+        template <typename Sig, std::size_t C, std::size_t A>
+        inline constexpr bool is_inplace_function<inplace_function<Sig, C, A>> = true;
+
+        template <typename F, typename R, typename... As>
+        concept callable_as = requires(F& f, As&&... as) { f(std::forward<As>(as)...); }
+                              && (std::is_void_v<R>
+                                  || std::is_convertible_v<decltype(std::declval<F&>()(std::declval<As>()...)), R>);
+
+        // Per-type operations, one static table per stored callable type.
+        template <typename R, bool Noexcept, typename... As>
+        struct inplace_ops {
+            R (*invoke)(void*, As&&...) noexcept(Noexcept);
+            void (*copy)(void* dst, const void* src);
+            void (*relocate)(void* dst, void* src) noexcept; // move-construct, destroy src
+            void (*destroy)(void*) noexcept;
+        };
+
+        template <typename R, bool Noexcept, typename... As>
+        inline constexpr inplace_ops<R, Noexcept, As...> empty_ops{
+            [](void*, As&&...) noexcept(Noexcept) -> R { std::terminate(); },
+            [](void*, const void*) { },
+            [](void*, void*) noexcept { },
+            [](void*) noexcept { },
+        };
+
+        template <typename F, typename R, bool Noexcept, typename... As>
+        inline constexpr inplace_ops<R, Noexcept, As...> ops_for{
+            [](void* f, As&&... as) noexcept(Noexcept) -> R {
+                if constexpr (std::is_void_v<R>)
+                    (*static_cast<F*>(f))(std::forward<As>(as)...);
+                else
+                    return (*static_cast<F*>(f))(std::forward<As>(as)...);
+            },
+            [](void* dst, const void* src) { ::new (dst) F(*static_cast<const F*>(src)); },
+            [](void* dst, void* src) noexcept {
+                ::new (dst) F(std::move(*static_cast<F*>(src)));
+                static_cast<F*>(src)->~F();
+            },
+            [](void* f) noexcept { static_cast<F*>(f)->~F(); },
+        };
+    } // namespace detail
+    /// @endcond
+
+    /**
+     * @brief Allocation-free replacement for `std::function<R(Args...)>`.
+     * @tparam R, Args, Noexcept Call signature; `R(Args...) noexcept` requires
+     *                            `noexcept`-callable targets.
+     * @tparam Capacity Inline buffer size in bytes.
+     * @tparam Align    Inline buffer alignment.
+     */
+    template <typename R, typename... As, bool Noexcept, std::size_t Capacity, std::size_t Align>
+    class inplace_function<R(As...) noexcept(Noexcept), Capacity, Align> {
+        using ops_t = detail::inplace_ops<R, Noexcept, As...>;
+
+    public:
+        using result_type = R;
+
+        static constexpr std::size_t capacity  = Capacity;
+        static constexpr std::size_t alignment = Align;
+
+        /// @brief Empty function.
+        constexpr inplace_function() noexcept = default;
+
+        /// @brief Empty function.
+        constexpr inplace_function(std::nullptr_t) noexcept { }
+
+        /// @brief Store a copy of @p f in the inline buffer.
+        template <typename F, typename D = std::decay_t<F>>
+            requires(!detail::is_inplace_function<D> && detail::callable_as<D, R, As...>)
+        inplace_function(F&& f) noexcept(std::is_nothrow_constructible_v<D, F>) {
+            static_assert(sizeof(D) <= Capacity, "inplace_function: callable larger than Capacity");
+            static_assert(alignof(D) <= Align, "inplace_function: callable over-aligned for Align");
+            static_assert(std::is_copy_constructible_v<D>, "inplace_function: callable must be copyable");
+            static_assert(std::is_nothrow_move_constructible_v<D>,
+                          "inplace_function: callable must be nothrow move constructible");
+            static_assert(!Noexcept || std::is_nothrow_invocable_v<D&, As...>,
+                          "inplace_function: noexcept signature needs a noexcept callable");
+            ::new (static_cast<void*>(buffer_)) D(std::forward<F>(f));
+            ops_ = &detail::ops_for<D, R, Noexcept, As...>;
+        }
+
+        inplace_function(const inplace_function& other)
+            : ops_(other.ops_) {
+            ops_->copy(buffer_, other.buffer_);
+        }
+
+        inplace_function(inplace_function&& other) noexcept
+            : ops_(other.ops_) {
+            ops_->relocate(buffer_, other.buffer_);
+            other.ops_ = &detail::empty_ops<R, Noexcept, As...>;
+        }
+
+        inplace_function& operator=(const inplace_function& other) {
+            if (this != &other) {
+                inplace_function tmp(other);
+                *this = std::move(tmp);
+            }
+            return *this;
+        }
+
+        inplace_function& operator=(inplace_function&& other) noexcept {
+            if (this != &other) {
+                ops_->destroy(buffer_);
+                ops_ = other.ops_;
+                ops_->relocate(buffer_, other.buffer_);
+                other.ops_ = &detail::empty_ops<R, Noexcept, As...>;
+            }
+            return *this;
+        }
+
+        inplace_function& operator=(std::nullptr_t) noexcept {
+            ops_->destroy(buffer_);
+            ops_ = &detail::empty_ops<R, Noexcept, As...>;
+            return *this;
+        }
+
+        ~inplace_function() { ops_->destroy(buffer_); }
+
+        /// @brief Call the stored callable; `std::terminate` if empty.
+        R operator()(As... as) const noexcept(Noexcept) {
+            return ops_->invoke(buffer_, std::forward<As>(as)...);
+        }
+
+        /// @brief Whether a callable is stored.
+        explicit operator bool() const noexcept { return ops_ != &detail::empty_ops<R, Noexcept, As...>; }
+
+        friend bool operator==(const inplace_function& f, std::nullptr_t) noexcept { return !f; }
+
+    private:
+        const ops_t* ops_ = &detail::empty_ops<R, Noexcept, As...>;
+        alignas(Align) mutable std::byte buffer_[Capacity];
+    };
+
+} // namespace ctql
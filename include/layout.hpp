@@ -0,0 +1,98 @@
+#pragma once
+
+#include "htlist.hpp"
+#include "predicates.hpp"
+#include "sorted.hpp"
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+/// @file
+/// @brief Padding-minimal field blocks built from typelists.
+/// @details
+/// A *field* is a type that is its own value, e.g. `struct Price { double v; };`.
+/// `field_block<HTList<Fs...>>` stores one of each field in list order and gives
+/// typed access with `get<F>()`. Combined with `align_sorted_t`, which orders fields
+/// by decreasing `alignof`, the block has no interior padding, so its size is the
+/// sum of the field sizes rounded up to the largest alignment.
+///
+/// ### Example
+///
+/// @code{.cpp}
+/// struct Flag  { bool on; };
+/// struct Price { double v; };
+/// struct Qty   { int n; };
+///
+/// using Order = ctql::align_sorted_t<Flag, Price, Qty>;   // HTList<Price, Qty, Flag>
+/// ctql::field_block<Order> b{};
+/// b.get<Price>().v = 1.5;
+/// static_assert(sizeof(b) == 16);
+/// @endcode
+///
+/// @note Fields must be distinct types; the block inherits one leaf per field.
+
+namespace ctql {
+
+    /// @cond INTERNAL
+    namespace detail {
+        template <typename F>
+        struct field_leaf {
+            F value;
+        };
+
+        // Sort key of field F at position I of N: alignment first, then position, so
+        // that the quicksort never has to order two equal keys.
+        template <typename F, std::size_t I, std::size_t N>
+        struct align_rank {
+            using type                        = F;
+            static constexpr std::size_t size = alignof(F) * N + (N - 1 - I);
+        };
+
+        template <typename Seq, typename... Fs>
+        struct align_sorted;
+
+        template <std::size_t... Is, typename... Fs>
+        struct align_sorted<std::index_sequence<Is...>, Fs...> {
+            using type = unwrap_t<typename sort_list<Order::Desc, HTList<align_rank<Fs, Is, sizeof...(Fs)>...>>::type>;
+        };
+    } // namespace detail
+    /// @endcond
+
+    /**
+     * @brief Storage for one value of each field type, laid out in list order.
+     * @tparam List `detail::HTList<Fs...>` of distinct field types.
+     */
+    template <typename List>
+    struct field_block;
+
+    template <typename... Fs>
+    struct field_block<detail::HTList<Fs...>> : detail::field_leaf<Fs>... {
+        using fields = detail::HTList<Fs...>;
+
+        /// @brief Whether @p F is stored in this block.
+        template <typename F>
+        static constexpr bool contains = (std::is_same_v<F, Fs> || ...);
+
+        /// @brief Access field @p F.
+        template <typename F>
+        constexpr F& get() noexcept {
+            return static_cast<detail::field_leaf<F>&>(*this).value;
+        }
+
+        /// @brief Access field @p F.
+        template <typename F>
+        constexpr const F& get() const noexcept {
+            return static_cast<const detail::field_leaf<F>&>(*this).value;
+        }
+    };
+
+    /**
+     * @brief Fields ordered by decreasing `alignof`, which removes interior padding.
+     * @details Fields of equal alignment keep their order in @p Fs.
+     * @tparam Fs Field types.
+     * @returns `detail::HTList<Fs...>` in layout order.
+     */
+    template <typename... Fs>
+    using align_sorted_t = typename detail::align_sorted<std::index_sequence_for<Fs...>, Fs...>::type;
+
+} // namespace ctql
@@ -10,7 +10,7 @@
 #define CTQL_APPEND(ListL, ListR)      typename ::ctql::detail::append<ListL, ListR>::type
 
 // Extractors
-#define CTQL_TO_TUPLE(List)            typename ::ctql::to_tuple<List>::type
+#define CTQL_TO_TUPLE(...)             typename ::ctql::to_tuple<__VA_ARGS__>::type
 #define CTQL_TO_VARIANT(List)          typename ::ctql::to_variant<List>::type
 #define CTQL_TUPLE_T(...)              std::tuple<__VA_ARGS__>
 
@@ -27,12 +27,15 @@
 #define CTQL_SORT_TYPES_ASC(KeyOf, ...)   ::ctql::TypeSort<::ctql::Order::Asc,  KeyOf, __VA_ARGS__>
 #define CTQL_SORT_TYPES_DESC(KeyOf, ...)  ::ctql::TypeSort<::ctql::Order::Desc, KeyOf, __VA_ARGS__>
 
+// Bin packing (first-fit-decreasing over KeyOf<T>::size)
+#define CTQL_BIN_PACK(Capacity, KeyOf, ...) ::ctql::bin_pack_t<Capacity, KeyOf, __VA_ARGS__>
+
 // Reducers over `.size`
 #define CTQL_REDUCE_SIZES(Op, Init, ...)  (::ctql::reduce_sizes_v<Op, Init, __VA_ARGS__>)
 #define CTQL_SUM_SIZES(...)               (::ctql::Sum_v<__VA_ARGS__>)
 
 // Matching 
-#define CTQL_MATCH(arg, ...)               std::invoke(ctql::match {__VA_ARGS__}, arg)
+#define CTQL_MATCH(arg, ...)               ctql::match {__VA_ARGS__}(arg)
 
 // Operation
 #define CTQL_OP(str)                      ctql::op_type<str##_ct>::template pred
@@ -48,7 +51,7 @@
 #  ifdef CTQL_ENABLE_DSL
     // Lists / transforms
 #   define $type_list(...)          CTQL_TYPE_LIST(__VA_ARGS__)
-#   define $to_tuple(List)          CTQL_TO_TUPLE(List)
+#   define $to_tuple(...)           CTQL_TO_TUPLE(__VA_ARGS__)
 #   define $to_variant(List)        CTQL_TO_VARIANT(List)
 #   define $tuple_t(...)            CTQL_TUPLE_T(__VA_ARGS__)
 
@@ -56,19 +59,25 @@
 #   define $partition_by(Pivot, Rel, ...)   CTQL_PARTITION_CONCAT(Pivot, Rel, __VA_ARGS__)
 #   define $filter_by(Pivot, Rel, ...)      CTQL_PARTITION_PASS(Pivot, Rel, __VA_ARGS__)
 #   define $reject_if_by(Pivot, Rel, ...)   CTQL_PARTITION_FAIL(Pivot, Rel, __VA_ARGS__)
+#   define $partition_by_key(KeyOf, Pivot, Rel, ...) CTQL_PARTITION_BY_KEY(Pivot, Rel, KeyOf, __VA_ARGS__)
 
     // Sorting short-hands (defaults to ascending)
 #   define $sort_types(...)             CTQL_TO_TUPLE(CTQL_SORT_TYPES(__VA_ARGS__))
 #   define $sort_types_by(KeyOf, ...)   CTQL_TO_TUPLE(CTQL_SORT_TYPES_ASC(KeyOf, __VA_ARGS__))
 #   define $sort_types_desc(KeyOf, ...) CTQL_TO_TUPLE(CTQL_SORT_TYPES_DESC(KeyOf, __VA_ARGS__))
 
+    // Bin packing
+#   define $bin_pack(Capacity, KeyOf, ...) CTQL_BIN_PACK(Capacity, KeyOf, __VA_ARGS__)
+
     // Reducers
 #   define $reduce_sizes(...)         CTQL_REDUCE_SIZES(__VA_ARGS__)  // (Op, Init, Ts...)
 #   define $sum_sizes(...)            CTQL_SUM_SIZES(__VA_ARGS__)     // (Ts...)
 #   define $size(n)                   CTQL_SIZE(n)
 
     // Matching
-#   define $match(arg, ...)           CTQL_MATCH(arg, __VA_ARGS__)
+#   ifndef $match // also defined next to ctql::match in ct_string.inl
+#    define $match(arg, ...)          CTQL_MATCH(arg, __VA_ARGS__)
+#   endif
 
     // Operation
 #   define $op(str)                   CTQL_OP(str)
@@ -0,0 +1,287 @@
+#pragma once
+
+#include "htlist.hpp"
+#include "match.hpp"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+/// @file
+/// @brief Runtime key -> type dispatch over the `case_` / `default_` alternatives of `match_t`.
+/// @details
+/// `match_t<Key, Alts...>` needs `Key` at compile time. `match_dispatch<Alts...>(key, visitor)`
+/// takes the same alternatives and a runtime `key`. It calls
+/// `visitor.template operator()<T>()` for the `case_<K, T>` with `K == key`. Otherwise it calls
+/// the `default_` type, or `void` if there is none, as `match_t` would pick. One
+/// alternatives list can then drive both the compile-time and the runtime decoder.
+///
+/// Keys must be integral or enumerations, and distinct. The lookup is chosen at compile
+/// time from the key set:
+/// - `linear`: up to `match_linear_max` cases, a chain of compares that the compiler
+///   lowers like a `switch` and that calls the visitor directly;
+/// - `dense`:  keys spanning at most twice their count, one function-pointer table
+///   indexed by `key - min`;
+/// - `hashed`: other key sets, a collision-free multiplicative hash into a table of
+///   (key, function) pairs found at compile time; one multiply, one shift, one compare.
+///
+/// ### Example
+///
+/// @code{.cpp}
+/// bool ok = ctql::match_dispatch<ctql::case_<0x01, MsgLogin>,
+///                                ctql::case_<0x20, MsgQuote>,
+///                                ctql::case_<0x7f, MsgPing>,
+///                                ctql::default_<MsgUnknown>>(
+///     header.type, [&]<class M>() { return decode<M>(payload); });
+/// @endcode
+
+namespace ctql {
+
+    /// @brief Lookup used by @ref match_dispatch for a set of alternatives.
+    enum class match_strategy { linear, dense, hashed };
+
+    /// @brief Largest number of cases looked up with the compare chain.
+    inline constexpr std::size_t match_linear_max = 4;
+
+    /// @cond INTERNAL
+    namespace detail {
+
+        template <typename Alt>
+        inline constexpr bool is_case = false;
+
+        template <auto K, typename T>
+        inline constexpr bool is_case<case_<K, T>> = true;
+
+        template <typename Alt>
+        inline constexpr bool is_default = false;
+
+        template <typename T>
+        inline constexpr bool is_default<default_<T>> = true;
+
+        // Integral and enum keys as 64 bits; signed values are sign-extended first,
+        // so a key compares equal whatever integer type carries it.
+        template <typename K>
+            requires(std::is_integral_v<K> || std::is_enum_v<K>)
+        constexpr std::uint64_t match_bits(K k) noexcept {
+            if constexpr (std::is_enum_v<K>)
+                return match_bits(static_cast<std::underlying_type_t<K>>(k));
+            else if constexpr (std::is_signed_v<K>)
+                return static_cast<std::uint64_t>(static_cast<std::int64_t>(k));
+            else
+                return static_cast<std::uint64_t>(k);
+        }
+
+        template <typename... Alts>
+        struct fallback_of {
+            using type = void;
+        };
+
+        template <typename T, typename... Rest>
+        struct fallback_of<default_<T>, Rest...> {
+            using type = T;
+        };
+
+        template <typename Alt, typename... Rest>
+        struct fallback_of<Alt, Rest...> : fallback_of<Rest...> { };
+
+        template <typename Alt>
+        inline constexpr std::uint64_t alt_bits = 0;
+
+        template <auto K, typename T>
+            requires(std::is_integral_v<decltype(K)> || std::is_enum_v<decltype(K)>)
+        inline constexpr std::uint64_t alt_bits<case_<K, T>> = match_bits(K);
+
+        template <typename Alt>
+        inline constexpr bool has_runtime_key = !is_case<Alt>;
+
+        template <auto K, typename T>
+        inline constexpr bool has_runtime_key<case_<K, T>> = std::is_integral_v<decltype(K)> || std::is_enum_v<decltype(K)>;
+
+        struct hash_plan {
+            std::uint64_t mul = 0;
+            unsigned shift    = 0;
+            std::size_t slots = 0; // 0: none found
+        };
+
+        // Smallest power-of-two table (up to 8x the key count) with a multiplier
+        // that sends every key to its own slot.
+        template <std::size_t N>
+        consteval hash_plan find_perfect_hash(const std::array<std::uint64_t, N>& keys) {
+            constexpr std::size_t max_slots = 8 * std::bit_ceil(N < 2 ? std::size_t{2} : N);
+            for (std::size_t slots = std::bit_ceil(N < 2 ? std::size_t{2} : N); slots <= max_slots; slots *= 2) {
+                const unsigned shift = 64 - static_cast<unsigned>(std::countr_zero(slots));
+                std::uint64_t mul    = 0x9e3779b97f4a7c15ull;
+                for (int attempt = 0; attempt < 256; ++attempt) {
+                    std::array<bool, max_slots> used{};
+                    bool ok = true;
+                    for (std::size_t i = 0; i < N && ok; ++i) {
+                        const std::size_t s = static_cast<std::size_t>((keys[i] * mul) >> shift);
+                        ok                  = !used[s];
+                        used[s]             = true;
+                    }
+                    if (ok)
+                        return {mul, shift, slots};
+                    mul = (mul * 6364136223846793005ull + 1442695040888963407ull) | 1;
+                }
+            }
+            return {};
+        }
+
+        template <typename... Alts>
+        struct match_table {
+            using alts = HTList<Alts...>;
+
+            static_assert(((is_case<Alts> || is_default<Alts>) && ...),
+                          "match_dispatch: alternatives must be case_<K, T> or default_<T>");
+            static_assert((std::size_t{is_default<Alts>} + ... + 0) <= 1, "match_dispatch: more than one default_");
+            static_assert((has_runtime_key<Alts> && ...), "match_dispatch: case_ keys must be integral or enum values");
+
+            static constexpr std::size_t size = (std::size_t{is_case<Alts>} + ... + 0);
+
+            // Position of each case_ among the alternatives, and its key.
+            static constexpr std::array<std::size_t, size> at = [] {
+                std::array<std::size_t, size> out{};
+                std::size_t n = 0, i = 0;
+                ((is_case<Alts> ? void(out[n++] = i++) : void(i++)), ...);
+                return out;
+            }();
+
+            static constexpr std::array<std::uint64_t, size> keys = [] {
+                constexpr std::array<std::uint64_t, sizeof...(Alts)> all{alt_bits<Alts>...};
+                std::array<std::uint64_t, size> out{};
+                for (std::size_t i = 0; i < size; ++i)
+                    out[i] = all[at[i]];
+                return out;
+            }();
+
+            static_assert(
+                [] {
+                    for (std::size_t i = 0; i < size; ++i)
+                        for (std::size_t j = i + 1; j < size; ++j)
+                            if (keys[i] == keys[j])
+                                return false;
+                    return true;
+                }(),
+                "match_dispatch: two case_ alternatives share a key");
+
+            template <std::size_t I>
+            using case_t = typename type_at_t<at[I], alts>::type;
+
+            using fallback = typename fallback_of<Alts...>::type;
+
+            // Shortest run of consecutive 64-bit values (wrapping at 2^64) that holds every
+            // key: it starts after the widest gap, so {-2, -1, 0, 1, 3} spans 6 values.
+            static constexpr std::array<std::uint64_t, 2> range = [] {
+                if constexpr (size == 0)
+                    return std::array<std::uint64_t, 2>{0, 0};
+                else {
+                    std::array<std::uint64_t, size> sorted = keys;
+                    for (std::size_t i = 1; i < size; ++i)
+                        for (std::size_t j = i; j > 0 && sorted[j - 1] > sorted[j]; --j)
+                            std::swap(sorted[j - 1], sorted[j]);
+                    std::size_t last = size - 1; // widest gap is after sorted[last]
+                    std::uint64_t gap = sorted[0] - sorted[size - 1];
+                    for (std::size_t i = 0; i + 1 < size; ++i)
+                        if (sorted[i + 1] - sorted[i] > gap) {
+                            gap  = sorted[i + 1] - sorted[i];
+                            last = i;
+                        }
+                    const std::uint64_t first = sorted[(last + 1) % size];
+                    return std::array<std::uint64_t, 2>{first, sorted[last] - first + 1};
+                }
+            }();
+
+            static constexpr std::uint64_t min_key = range[0];
+            static constexpr std::uint64_t span    = range[1];
+
+            static constexpr hash_plan hash = size > match_linear_max ? find_perfect_hash(keys) : hash_plan{};
+
+            static constexpr match_strategy strategy
+                = size <= match_linear_max || (span > 2 * size && hash.slots == 0) ? match_strategy::linear
+                  : span <= 2 * size                                              ? match_strategy::dense
+                                                                                  : match_strategy::hashed;
+
+            template <typename R, typename V, typename T>
+            static constexpr R call(V& v) {
+                return v.template operator()<T>();
+            }
+
+            template <typename R, typename V, std::size_t I = 0>
+            static constexpr R linear(std::uint64_t k, V& v) {
+                if constexpr (I == size)
+                    return call<R, V, fallback>(v);
+                else {
+                    if (k == keys[I])
+                        return call<R, V, case_t<I>>(v);
+                    return linear<R, V, I + 1>(k, v);
+                }
+            }
+
+            template <typename R, typename V>
+            static constexpr auto dense = [] {
+                std::array<R (*)(V&), span> out{};
+                out.fill(&call<R, V, fallback>);
+                [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                    ((out[keys[Is] - min_key] = &call<R, V, case_t<Is>>), ...);
+                }(std::make_index_sequence<size>{});
+                return out;
+            }();
+
+            template <typename R, typename V>
+            struct entry {
+                std::uint64_t key = 0; // empty slots call the fallback, whatever the key
+                R (*fn)(V&)       = &call<R, V, fallback>;
+            };
+
+            template <typename R, typename V>
+            static constexpr auto hashed = [] {
+                std::array<entry<R, V>, hash.slots> out{};
+                [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                    ((out[(keys[Is] * hash.mul) >> hash.shift] = entry<R, V>{keys[Is], &call<R, V, case_t<Is>>}), ...);
+                }(std::make_index_sequence<size>{});
+                return out;
+            }();
+        };
+
+    } // namespace detail
+    /// @endcond
+
+    /// @brief The @ref match_strategy that `match_dispatch<Alts...>` uses.
+    template <typename... Alts>
+    inline constexpr match_strategy match_strategy_v = detail::match_table<Alts...>::strategy;
+
+    /**
+     * @brief Call `visitor.template operator()<T>()` for the alternative matching @p key.
+     * @tparam Alts `case_<K, T>` alternatives with distinct integral or enum keys, and at
+     *              most one `default_<D>` (used when no key matches; `void` without one).
+     * @param key     Runtime key, compared with each `K` after conversion to 64 bits.
+     * @param visitor Callable with a `template <class T>` call operator; every
+     *                instantiation must return the same type.
+     * @returns Whatever the visitor returns.
+     */
+    template <typename... Alts, typename Key, typename Visitor>
+        requires(std::is_integral_v<Key> || std::is_enum_v<Key>)
+    constexpr decltype(auto) match_dispatch(Key key, Visitor&& visitor) {
+        using M = detail::match_table<Alts...>;
+        using V = std::remove_reference_t<Visitor>;
+        using R = decltype(visitor.template operator()<typename M::fallback>());
+
+        const std::uint64_t k = detail::match_bits(key);
+        if constexpr (M::strategy == match_strategy::linear)
+            return M::template linear<R, V>(k, visitor);
+        else if constexpr (M::strategy == match_strategy::dense) {
+            const std::uint64_t slot = k - M::min_key; // wraps, like the range
+            if (slot >= M::span)
+                return M::template call<R, V, typename M::fallback>(visitor);
+            return M::template dense<R, V>[slot](visitor);
+        } else {
+            const auto& e = M::template hashed<R, V>[(k * M::hash.mul) >> M::hash.shift];
+            if (e.key != k)
+                return M::template call<R, V, typename M::fallback>(visitor);
+            return e.fn(visitor);
+        }
+    }
+
+} // namespace ctql
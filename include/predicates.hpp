@@ -2,7 +2,6 @@
 #include "htlist.hpp"
 #include <concepts>
 #include <cstddef>
-#include <functional>
 #include <ct_string.inl>
 #include <match.hpp>
 
@@ -10,7 +9,8 @@
 /// @brief Size/align key wrappers, comparison predicates, and operator tag mapping.
 /// @details
 /// - `HasStaticSize` concept gates types that expose `static constexpr std::size_t size`.
-/// - `Size<T>`, `SizeOf<T>`, `AlignOf<T>` present a unified `::type` and `::size`.
+/// - `Size<T>`, `SizeOf<T>`, `AlignOf<T>` present a unified `::type` and `::size`;
+///   `SizeConst<N>` is a bare constant key for pivots.
 /// - `cmp`, `PredBy`, `op_tag`, and `ops` build size-based predicates.
 /// - `op_type<"...">` maps a compile-time string token (e.g. `"<"_ct`) to an operator tag
 ///   whose `template pred<L,R>` can be used in algorithms (e.g. partition/sort).
@@ -70,6 +70,47 @@ namespace ctql {
         static constexpr std::size_t size = alignof(T);
     };
 
+    /**
+     * @brief Constant key with no underlying type, e.g. a partition pivot or threshold.
+     * @tparam N The size value.
+     */
+    template <std::size_t N>
+    struct SizeConst {
+        using type                        = void;
+        static constexpr std::size_t size = N;
+    };
+
+    /// @cond INTERNAL
+    namespace detail {
+        // Transparent comparators behind @ref ops. They stand in for std::less<> & co.
+        // so that the predicates do not need <functional>.
+        struct less {
+            template <typename L, typename R>
+            constexpr bool operator()(const L& l, const R& r) const { return l < r; }
+        };
+        struct less_equal {
+            template <typename L, typename R>
+            constexpr bool operator()(const L& l, const R& r) const { return l <= r; }
+        };
+        struct greater {
+            template <typename L, typename R>
+            constexpr bool operator()(const L& l, const R& r) const { return l > r; }
+        };
+        struct greater_equal {
+            template <typename L, typename R>
+            constexpr bool operator()(const L& l, const R& r) const { return l >= r; }
+        };
+        struct equal_to {
+            template <typename L, typename R>
+            constexpr bool operator()(const L& l, const R& r) const { return l == r; }
+        };
+        struct not_equal_to {
+            template <typename L, typename R>
+            constexpr bool operator()(const L& l, const R& r) const { return l != r; }
+        };
+    } // namespace detail
+    /// @endcond
+
     /**
      * @brief Compare two `HasStaticSize` types using a standard comparator.
      * @tparam Cmp A callable like `std::less<>`, `std::greater_equal<>`, etc.
@@ -103,6 +144,9 @@ namespace ctql {
      */
     template <typename Cmp>
     struct op_tag {
+        /// @brief The underlying comparator, for value-level algorithms.
+        using compare = Cmp;
+
         template <typename L, typename R>
         using pred = typename PredBy<Cmp>::template t<L, R>;
     };
@@ -118,12 +162,12 @@ namespace ctql {
      * - `neq`: `!=`
      */
     struct ops {
-        using leq = op_tag<std::less_equal<>>;
-        using geq = op_tag<std::greater_equal<>>;
-        using lt  = op_tag<std::less<>>;
-        using gt  = op_tag<std::greater<>>;
-        using eq  = op_tag<std::equal_to<>>;
-        using neq = op_tag<std::not_equal_to<>>;
+        using leq = op_tag<detail::less_equal>;
+        using geq = op_tag<detail::greater_equal>;
+        using lt  = op_tag<detail::less>;
+        using gt  = op_tag<detail::greater>;
+        using eq  = op_tag<detail::equal_to>;
+        using neq = op_tag<detail::not_equal_to>;
     };
 
     /**
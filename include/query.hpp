@@ -0,0 +1,156 @@
+#pragma once
+
+#include "htlist.hpp"
+#include "predicates.hpp"
+#include "sorted.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <utility>
+
+/// @file
+/// @brief Lazy, fused filter / order / project pipeline over a type pack.
+/// @details
+/// Chaining `filter_by`, `TypeSort` and `to_tuple` materializes an `HTList` after
+/// every step, and `sort_list` partitions again at every level of its recursion.
+/// `query<Ts...>` only records the steps:
+///
+/// - `where<Pivot, Rel, KeyOf = Size>` keeps `T` if `Rel<Pivot, KeyOf<T>>::value`
+///   (the relation form used by `partition_by_key`); several `where`s are ANDed;
+/// - `order_by<Ord, KeyOf = Size>` orders by `KeyOf<T>::size`, stable for ties;
+/// - `select<KeyOf>` projects every surviving `T` to `KeyOf<T>` (default: `T`).
+///
+/// Nothing is computed until a terminal alias is named: `to<W>` gives `W<...>`,
+/// `list<>` gives a `detail::HTList<...>`. The terminal runs a single constant
+/// evaluation over an index array (filter, then sort the surviving indices), and
+/// instantiates the one result list.
+///
+/// ### Example
+///
+/// @code{.cpp}
+/// using Small = ctql::query<MsgLogin, MsgPing, MsgChunk, MsgTelemetry>
+///     ::where<MTU1200, ctql::ops::geq::template pred, WireSizeOf>
+///     ::order_by<ctql::Order::Asc, WireSizeOf>
+///     ::to<std::tuple>;                    // std::tuple<MsgPing, MsgLogin, MsgTelemetry>
+/// @endcode
+///
+/// @note Inside a template, dependent chains need `::template where<...>`.
+
+namespace ctql {
+
+    /// @cond INTERNAL
+    namespace detail {
+
+        template <typename Pivot, template <typename, typename> class Rel, template <typename> class KeyOf>
+        struct where_clause {
+            template <typename T>
+            static constexpr bool test = Rel<Pivot, KeyOf<T>>::value;
+        };
+
+        struct no_order { };
+
+        template <Order Ord, template <typename> class KeyOf>
+        struct order_clause { };
+
+        template <typename T>
+        struct identity_key {
+            using type = T;
+        };
+
+        template <typename T>
+        using identity_t = typename identity_key<T>::type;
+
+        template <typename T, typename... Clauses>
+        inline constexpr bool passes_all = (Clauses::template test<T> && ...);
+
+        template <typename OrderC, typename T>
+        inline constexpr std::size_t order_key = 0;
+
+        template <Order Ord, template <typename> class KeyOf, typename T>
+        inline constexpr std::size_t order_key<order_clause<Ord, KeyOf>, T> = static_cast<std::size_t>(KeyOf<T>::size);
+
+        template <typename OrderC>
+        inline constexpr bool is_ordered = false;
+
+        template <Order Ord, template <typename> class KeyOf>
+        inline constexpr bool is_ordered<order_clause<Ord, KeyOf>> = true;
+
+        template <typename OrderC>
+        inline constexpr Order order_of = Order::Asc;
+
+        template <Order Ord, template <typename> class KeyOf>
+        inline constexpr Order order_of<order_clause<Ord, KeyOf>> = Ord;
+
+        template <std::size_t N>
+        struct query_plan {
+            std::array<std::size_t, N> idx{};
+            std::size_t len = 0;
+        };
+
+        // Surviving indices, then (optionally) sorted by key; index breaks ties.
+        template <std::size_t N>
+        consteval query_plan<N> plan_query(std::array<bool, N> keep, std::array<std::size_t, N> key,
+                                           bool ordered, Order ord) {
+            query_plan<N> plan;
+            for (std::size_t i = 0; i < N; ++i)
+                if (keep[i])
+                    plan.idx[plan.len++] = i;
+            if (ordered)
+                std::sort(plan.idx.begin(), plan.idx.begin() + plan.len, [&](std::size_t a, std::size_t b) {
+                    if (key[a] != key[b])
+                        return ord == Order::Asc ? key[a] < key[b] : key[a] > key[b];
+                    return a < b;
+                });
+            return plan;
+        }
+
+        template <template <typename...> class W, template <typename> class Select, typename List, auto Plan,
+                  typename Seq = std::make_index_sequence<Plan.len>>
+        struct query_result;
+
+        template <template <typename...> class W, template <typename> class Select, typename List, auto Plan,
+                  std::size_t... Is>
+        struct query_result<W, Select, List, Plan, std::index_sequence<Is...>> {
+            using type = W<Select<type_at_t<Plan.idx[Is], List>>...>;
+        };
+
+        template <typename List, typename Wheres, typename OrderC, template <typename> class Select>
+        struct query_expr;
+
+        template <typename... Ts, typename... Ws, typename OrderC, template <typename> class Select>
+        struct query_expr<HTList<Ts...>, HTList<Ws...>, OrderC, Select> {
+            /// @brief Also keep only `T` with `Rel<Pivot, KeyOf<T>>::value`.
+            template <typename Pivot, template <typename, typename> class Rel, template <typename> class KeyOf = Size>
+            using where = query_expr<HTList<Ts...>, HTList<Ws..., where_clause<Pivot, Rel, KeyOf>>, OrderC, Select>;
+
+            /// @brief Order by `KeyOf<T>::size` (replaces an earlier `order_by`).
+            template <Order Ord = Order::Asc, template <typename> class KeyOf = Size>
+            using order_by = query_expr<HTList<Ts...>, HTList<Ws...>, order_clause<Ord, KeyOf>, Select>;
+
+            /// @brief Project the result to `KeyOf<T>`.
+            template <template <typename> class KeyOf>
+            using select = query_expr<HTList<Ts...>, HTList<Ws...>, OrderC, KeyOf>;
+
+            /// @brief Evaluate into `W<...>`, e.g. `std::tuple` or `std::variant`.
+            template <template <typename...> class W>
+            using to = typename query_result<
+                W, Select, HTList<Ts...>,
+                plan_query<sizeof...(Ts)>({passes_all<Ts, Ws...>...}, {order_key<OrderC, Ts>...},
+                                          is_ordered<OrderC>, order_of<OrderC>)>::type;
+
+            /// @brief Evaluate into a `detail::HTList` (an alias template, so it stays lazy).
+            template <typename = void>
+            using list = to<HTList>;
+        };
+
+    } // namespace detail
+    /// @endcond
+
+    /**
+     * @brief Start a lazy query over @p Ts.
+     * @details See the file documentation; evaluate with `::to<W>` or `::list<>`.
+     */
+    template <typename... Ts>
+    using query = detail::query_expr<detail::HTList<Ts...>, detail::HTList<>, detail::no_order, detail::identity_t>;
+
+} // namespace ctql
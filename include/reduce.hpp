@@ -2,6 +2,7 @@
 
 #include "htlist.hpp"
 #include "predicates.hpp"
+#include <array>
 #include <type_traits>
 
 /// @file
@@ -9,7 +10,8 @@
 /// @details
 /// Folds a pack of types that expose a static size (via the `HasStaticSize` predicate)
 /// using a user-supplied binary meta-op on `std::size_t`.
-/// The public API is the `{reduce_sizes_t, reduce_sizes_v}` pair, plus `Sum{,_v}`.
+/// The public API is the `{reduce_sizes_t, reduce_sizes_v}` pair, plus `Sum{,_v}`,
+/// `Min{,_v}`, `Max{,_v}` and the prefix-sum `{exclusive_scan_t, exclusive_scan_v}` pair.
 /// Complexity is linear in the number of types.
 ///
 /// ### Example
@@ -49,11 +51,47 @@ namespace ctql {
         template <std::size_t A, std::size_t B>
         struct add_i : std::integral_constant<std::size_t, A + B> { };
 
-        template <std::size_t A, std::size_t B>
-        struct min_i : std::integral_constant<std::size_t, (A < B ? A : B)> { };
-
-        template <std::size_t A, std::size_t B>
-        struct max_i : std::integral_constant<std::size_t, (A < B ? B : A)> { };
+        // Position of the first smallest / largest key; one linear pass, no recursion.
+        template <std::size_t N>
+        constexpr std::size_t min_index(const std::array<std::size_t, N>& keys) noexcept {
+            std::size_t at = 0;
+            for (std::size_t i = 1; i < N; ++i)
+                if (keys[i] < keys[at])
+                    at = i;
+            return at;
+        }
+
+        template <std::size_t N>
+        constexpr std::size_t max_index(const std::array<std::size_t, N>& keys) noexcept {
+            std::size_t at = 0;
+            for (std::size_t i = 1; i < N; ++i)
+                if (keys[i] > keys[at])
+                    at = i;
+            return at;
+        }
+
+        // size_keys<Ks...>: the Ks::size as one array, plus its extremes.
+        template <HasStaticSize... Ks>
+        struct size_keys {
+            static_assert(sizeof...(Ks) > 0, "ctql: Min/Max of an empty pack");
+
+            static constexpr std::array<std::size_t, sizeof...(Ks)> value{static_cast<std::size_t>(Ks::size)...};
+            static constexpr std::size_t min = value[min_index(value)];
+            static constexpr std::size_t max = value[max_index(value)];
+        };
+
+        // scan_sizes<Ks...>: exclusive prefix sum of Ks::size as one array.
+        template <HasStaticSize... Ks>
+        struct scan_sizes {
+            using value_type = std::array<std::size_t, sizeof...(Ks)>;
+
+            static constexpr value_type value = [] {
+                value_type out{};
+                std::size_t at = 0, i = 0;
+                ((out[i++] = at, at += static_cast<std::size_t>(Ks::size)), ...);
+                return out;
+            }();
+        };
 
     } // namespace detail
     /// @endcond
@@ -98,4 +136,53 @@ namespace ctql {
     template <typename... Ts>
     inline constexpr std::size_t Sum_v = Sum<Ts...>::value;
 
+    /**
+     * @brief Smallest `Ts::size` of a non-empty pack of `HasStaticSize` types.
+     * @returns Alias to `std::integral_constant<size_t, min>`.
+     * @see min_by_t for the type that has it.
+     */
+    template <typename... Ts>
+    using Min = std::integral_constant<std::size_t, detail::size_keys<Ts...>::min>;
+
+    /// @brief Convenience value for @ref Min.
+    template <typename... Ts>
+    inline constexpr std::size_t Min_v = Min<Ts...>::value;
+
+    /**
+     * @brief Largest `Ts::size` of a non-empty pack of `HasStaticSize` types.
+     * @returns Alias to `std::integral_constant<size_t, max>`.
+     * @see max_by_t for the type that has it.
+     */
+    template <typename... Ts>
+    using Max = std::integral_constant<std::size_t, detail::size_keys<Ts...>::max>;
+
+    /// @brief Convenience value for @ref Max.
+    template <typename... Ts>
+    inline constexpr std::size_t Max_v = Max<Ts...>::value;
+
+    /**
+     * @brief Exclusive prefix sum of `KeyOf<Ts>::size`, e.g. field offsets.
+     *
+     * @tparam KeyOf Unary key wrapper (e.g. `SizeOf`, `Size`).
+     * @tparam Ts    Input types.
+     * @returns A type whose `value` is a `std::array<size_t, sizeof...(Ts)>` with
+     *          `value[i] = KeyOf<T0>::size + ... + KeyOf<T(i-1)>::size`.
+     *
+     * **Example**
+     *
+     * @code{.cpp}
+     * static_assert(ctql::exclusive_scan_v<ctql::SizeOf, std::uint32_t, std::uint8_t, std::uint64_t>
+     *               == std::array<std::size_t, 3>{0, 4, 5});
+     * @endcode
+     *
+     * @par Complexity
+     * One instantiation; linear in `sizeof...(Ts)`.
+     */
+    template <template <typename> class KeyOf, typename... Ts>
+    using exclusive_scan_t = detail::scan_sizes<KeyOf<Ts>...>;
+
+    /// @brief Convenience value for @ref exclusive_scan_t.
+    template <template <typename> class KeyOf, typename... Ts>
+    inline constexpr auto exclusive_scan_v = exclusive_scan_t<KeyOf, Ts...>::value;
+
 } // namespace ctql
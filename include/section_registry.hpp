@@ -0,0 +1,171 @@
+#pragma once
+
+#include "type_id.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <thread>
+#include <type_traits>
+
+/// @file
+/// @brief Handler registry collected by the linker, with no static initialization.
+/// @details
+/// Registering handlers from static constructors costs startup time and depends on
+/// initialization order. Here each registration is a constant-initialized
+/// `registry_entry` placed in a named ELF section; the linker concatenates the
+/// entries of every object file and brackets them with `__start_<section>` /
+/// `__stop_<section>`:
+///
+/// - `CTQL_SECTION_REGISTRY(name)` declares the registry `name` (once, in a header);
+/// - `CTQL_REGISTER_HANDLER(name, Msg, fn)` adds `fn(const Msg&)` for `Msg`, in any
+///   translation unit, at namespace scope;
+/// - on first use, `name.entries()` checks that the entries are sorted by
+///   @ref stable_type_id and sorts them in place if not, in one pass under a spin
+///   flag. Lookups are then binary searches.
+///
+/// No constructor runs and nothing is allocated. Entries are keyed by
+/// `stable_type_id_v<Msg>`, a hash of the type's name, so objects built separately
+/// agree on the ids. ELF targets only (GCC and Clang).
+///
+/// ### Example
+///
+/// @code{.cpp}
+/// // messages.hpp
+/// CTQL_SECTION_REGISTRY(msg_handlers);
+///
+/// // risk_plugin.cpp
+/// void on_fill(const Fill& f) { exposure += f.qty; }
+/// CTQL_REGISTER_HANDLER(msg_handlers, Fill, on_fill);
+///
+/// // main loop
+/// msg_handlers.dispatch(fill); // every handler registered for Fill, in any object
+/// @endcode
+
+namespace ctql {
+
+    /// @brief One registration: the message type, its handler and its size.
+    /// @details 8-byte aligned on every target, so that its size is the stride of the
+    ///          entries the linker packs between the section bounds.
+    struct alignas(8) registry_entry {
+        std::uint64_t id;                   ///< `stable_type_id_v<Msg>`.
+        void (*handler)(const void* msg);   ///< Calls the registered function with `*static_cast<const Msg*>(msg)`.
+        std::uint32_t size;                 ///< `sizeof(Msg)`.
+        std::uint32_t align;                ///< `alignof(Msg)`.
+
+        /// @brief Entry calling `Fn(const Msg&)`.
+        template <typename Msg, auto Fn>
+            requires std::is_invocable_v<decltype(Fn), const Msg&>
+        static constexpr registry_entry make() noexcept {
+            return {stable_type_id_v<Msg>, [](const void* msg) { Fn(*static_cast<const Msg*>(msg)); },
+                    static_cast<std::uint32_t>(sizeof(Msg)), static_cast<std::uint32_t>(alignof(Msg))};
+        }
+    };
+
+    static_assert(sizeof(registry_entry) % alignof(registry_entry) == 0 && alignof(registry_entry) == 8,
+                  "registry_entry: entries must pack with no gaps at the 8-byte alignment of the section");
+
+    /**
+     * @brief The entries between two linker-provided bounds, sorted by id on first use.
+     * @details Constant-initialized; declare it with @ref CTQL_SECTION_REGISTRY.
+     */
+    class section_registry {
+    public:
+        constexpr section_registry(registry_entry* first, registry_entry* last) noexcept
+            : first_(first)
+            , last_(last) { }
+
+        section_registry(const section_registry&)            = delete;
+        section_registry& operator=(const section_registry&) = delete;
+
+        /// @brief Every entry, by ascending id (handlers of one id in unspecified order).
+        std::span<const registry_entry> entries() noexcept {
+            if (state_.load(std::memory_order_acquire) != ready)
+                prepare();
+            return {first_, last_};
+        }
+
+        /// @brief Entries registered for the type with id @p id.
+        std::span<const registry_entry> find(std::uint64_t id) noexcept {
+            const auto all = entries();
+            const auto [lo, hi] = std::equal_range(all.begin(), all.end(), id, by_id{});
+            return {lo, hi};
+        }
+
+        /// @brief Entries registered for @p Msg.
+        template <typename Msg>
+        std::span<const registry_entry> find() noexcept {
+            return find(stable_type_id_v<Msg>);
+        }
+
+        /// @brief Call every handler registered for `Msg` with @p msg.
+        /// @returns Number of handlers called.
+        template <typename Msg>
+        std::size_t dispatch(const Msg& msg) {
+            const auto hs = find<Msg>();
+            for (const registry_entry& e : hs)
+                e.handler(&msg);
+            return hs.size();
+        }
+
+    private:
+        enum : int { unsorted, sorting, ready };
+
+        struct by_id {
+            bool operator()(const registry_entry& e, std::uint64_t id) const noexcept { return e.id < id; }
+            bool operator()(std::uint64_t id, const registry_entry& e) const noexcept { return id < e.id; }
+            bool operator()(const registry_entry& a, const registry_entry& b) const noexcept { return a.id < b.id; }
+        };
+
+        void prepare() noexcept {
+            int expected = unsorted;
+            if (state_.compare_exchange_strong(expected, sorting, std::memory_order_acquire)) {
+                if (!std::is_sorted(first_, last_, by_id{}))
+                    std::sort(first_, last_, by_id{});
+                state_.store(ready, std::memory_order_release);
+                return;
+            }
+            while (state_.load(std::memory_order_acquire) != ready)
+                std::this_thread::yield();
+        }
+
+        registry_entry* first_;
+        registry_entry* last_;
+        std::atomic<int> state_{unsorted};
+    };
+
+} // namespace ctql
+
+/// @cond INTERNAL
+#define CTQL_REGISTRY_CAT_(a, b) a##b
+#define CTQL_REGISTRY_CAT(a, b)  CTQL_REGISTRY_CAT_(a, b)
+/// @endcond
+
+#if defined(__ELF__) && (defined(__GNUC__) || defined(__clang__))
+
+/**
+ * @brief Declare registry @p name over ELF section `ctql_<name>`.
+ * @details Namespace scope, once per program (e.g. in a header). The bounds are weak,
+ *          so a registry without entries is empty rather than a link error.
+ */
+#  define CTQL_SECTION_REGISTRY(name)                                                               \
+      extern "C" [[gnu::weak, gnu::visibility("hidden")]] ::ctql::registry_entry __start_ctql_##name[]; \
+      extern "C" [[gnu::weak, gnu::visibility("hidden")]] ::ctql::registry_entry __stop_ctql_##name[];  \
+      constinit inline ::ctql::section_registry name { __start_ctql_##name, __stop_ctql_##name }
+
+/**
+ * @brief Register `fn(const Msg&)` in registry @p name.
+ * @details Namespace scope, any number of times in any translation unit. The entry is
+ *          8-byte aligned so that entries from different objects pack without gaps.
+ */
+#  define CTQL_REGISTER_HANDLER(name, Msg, fn)                                                     \
+      [[gnu::used, gnu::section("ctql_" #name), gnu::aligned(8)]] static constinit ::ctql::registry_entry \
+          CTQL_REGISTRY_CAT(ctql_registry_entry_, __COUNTER__) = ::ctql::registry_entry::make<Msg, fn>()
+
+#else
+
+#  define CTQL_SECTION_REGISTRY(name) static_assert(false, "CTQL_SECTION_REGISTRY needs an ELF target")
+#  define CTQL_REGISTER_HANDLER(name, Msg, fn) static_assert(false, "CTQL_REGISTER_HANDLER needs an ELF target")
+
+#endif
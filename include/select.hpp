@@ -0,0 +1,148 @@
+#pragma once
+
+#include "htlist.hpp"
+#include "predicates.hpp"
+#include "reduce.hpp"
+#include <array>
+#include <cstddef>
+#include <utility>
+
+/// @file
+/// @brief Selection over a type pack by key: min, max, top-k and n-th element.
+/// @details
+/// Picking the largest type or the median-sized one with `TypeSort` sorts the
+/// whole pack first. These aliases instead compute one `KeyOf<Ts>::size` array and
+/// select positions in it with a constant evaluation, then return the original
+/// `Ts` (not the keys):
+///
+/// - `min_by_t<KeyOf, Ts...>` / `max_by_t<KeyOf, Ts...>`: one linear pass; the
+///   first of equal keys wins;
+/// - `nth_t<N, KeyOf, Ts...>`: the type at position `N` of the stable ascending
+///   order (quickselect, expected linear);
+/// - `top_k_t<K, KeyOf, Ts...>`: the `K` largest as a `detail::HTList`, largest
+///   first, ties in pack order (quickselect, then a sort of the `K` winners).
+///
+/// Ties are broken by position, so every result is the one a stable sort gives.
+///
+/// ### Example
+///
+/// @code{.cpp}
+/// using Biggest = ctql::max_by_t<ctql::SizeOf, MsgLogin, MsgPing, MsgChunk>;       // MsgChunk
+/// using Median  = ctql::nth_t<1, ctql::SizeOf, MsgLogin, MsgPing, MsgChunk>;       // MsgLogin
+/// using Hot     = ctql::top_k_t<2, HitRate, MsgLogin, MsgPing, MsgChunk, MsgQuote>; // HTList<...>
+/// @endcode
+
+namespace ctql {
+
+    /// @cond INTERNAL
+    namespace detail {
+
+        // Reorders the indices 0..N-1 so that position n holds the n-th by (key, index),
+        // ascending or descending by key, with everything before it ranked ahead of it.
+        template <std::size_t N>
+        consteval std::array<std::size_t, N> select_first(const std::array<std::size_t, N>& key, std::size_t n,
+                                                          bool desc) {
+            std::array<std::size_t, N> idx{};
+            for (std::size_t i = 0; i < N; ++i)
+                idx[i] = i;
+            auto before = [&](std::size_t a, std::size_t b) {
+                if (key[a] != key[b])
+                    return desc ? key[a] > key[b] : key[a] < key[b];
+                return a < b;
+            };
+
+            std::size_t lo = 0, hi = N;
+            while (hi - lo > 1) {
+                // Median of three as the pivot, moved to hi - 1.
+                const std::size_t mid = lo + (hi - lo) / 2;
+                if (before(idx[mid], idx[lo]))
+                    std::swap(idx[mid], idx[lo]);
+                if (before(idx[hi - 1], idx[lo]))
+                    std::swap(idx[hi - 1], idx[lo]);
+                if (before(idx[mid], idx[hi - 1]))
+                    std::swap(idx[mid], idx[hi - 1]);
+
+                const std::size_t pivot = idx[hi - 1];
+                std::size_t store       = lo;
+                for (std::size_t i = lo; i + 1 < hi; ++i)
+                    if (before(idx[i], pivot))
+                        std::swap(idx[i], idx[store++]);
+                std::swap(idx[store], idx[hi - 1]);
+
+                if (n == store)
+                    break;
+                if (n < store)
+                    hi = store;
+                else
+                    lo = store + 1;
+            }
+            return idx;
+        }
+
+        template <std::size_t K, std::size_t N>
+        consteval std::array<std::size_t, K> top_k_indices(const std::array<std::size_t, N>& key) {
+            std::array<std::size_t, K> out{};
+            if constexpr (K > 0) {
+                const auto idx = select_first(key, K - 1, true);
+                for (std::size_t i = 0; i < K; ++i) {
+                    // Insertion sort of the winners; K is small next to N.
+                    std::size_t j = i;
+                    for (; j > 0
+                           && (key[out[j - 1]] < key[idx[i]] || (key[out[j - 1]] == key[idx[i]] && out[j - 1] > idx[i]));
+                         --j)
+                        out[j] = out[j - 1];
+                    out[j] = idx[i];
+                }
+            }
+            return out;
+        }
+
+        template <template <typename> class KeyOf, typename... Ts>
+        inline constexpr std::array<std::size_t, sizeof...(Ts)> keys_of{static_cast<std::size_t>(KeyOf<Ts>::size)...};
+
+        template <typename List, auto Idx, typename Seq = std::make_index_sequence<Idx.size()>>
+        struct pick;
+
+        template <typename List, auto Idx, std::size_t... Is>
+        struct pick<List, Idx, std::index_sequence<Is...>> {
+            using type = HTList<type_at_t<Idx[Is], List>...>;
+        };
+
+    } // namespace detail
+    /// @endcond
+
+    /**
+     * @brief The type among @p Ts with the smallest `KeyOf<T>::size` (the first, on ties).
+     * @tparam KeyOf Unary key wrapper (e.g. `SizeOf`, `Size`).
+     */
+    template <template <typename> class KeyOf, typename T0, typename... Ts>
+    using min_by_t =
+        detail::type_at_t<detail::min_index(detail::keys_of<KeyOf, T0, Ts...>), detail::HTList<T0, Ts...>>;
+
+    /**
+     * @brief The type among @p Ts with the largest `KeyOf<T>::size` (the first, on ties).
+     * @tparam KeyOf Unary key wrapper (e.g. `SizeOf`, `Size`).
+     */
+    template <template <typename> class KeyOf, typename T0, typename... Ts>
+    using max_by_t =
+        detail::type_at_t<detail::max_index(detail::keys_of<KeyOf, T0, Ts...>), detail::HTList<T0, Ts...>>;
+
+    /**
+     * @brief The type at position @p N of @p Ts stably sorted by ascending `KeyOf<T>::size`.
+     * @details `nth_t<0, ...>` is `min_by_t<...>`; `nth_t<sizeof...(Ts) / 2, ...>` is the median.
+     */
+    template <std::size_t N, template <typename> class KeyOf, typename... Ts>
+        requires(N < sizeof...(Ts))
+    using nth_t = detail::type_at_t<detail::select_first(detail::keys_of<KeyOf, Ts...>, N, false)[N],
+                                    detail::HTList<Ts...>>;
+
+    /**
+     * @brief The @p K types of @p Ts with the largest `KeyOf<T>::size`, largest first.
+     * @returns `detail::HTList<...>` of original types; equal keys keep pack order.
+     */
+    template <std::size_t K, template <typename> class KeyOf, typename... Ts>
+        requires(K <= sizeof...(Ts))
+    using top_k_t = typename detail::pick<detail::HTList<Ts...>,
+                                          detail::top_k_indices<K>(detail::keys_of<KeyOf, Ts...>)>::type;
+
+} // namespace ctql
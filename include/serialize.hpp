@@ -0,0 +1,362 @@
+#pragma once
+
+#include "htlist.hpp"
+#include "reduce.hpp"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+/// @file
+/// @brief memcpy-coalescing binary serialization of `HTList`-described records.
+/// @details
+/// A record is described by a list of @ref field descriptors, one per member, in
+/// wire order:
+///
+/// @code{.cpp}
+/// struct Quote { std::uint64_t id; std::uint32_t px; std::uint32_t qty; Symbol sym; };
+/// using QuoteWire = ctql::detail::HTList<
+///     ctql::field<&Quote::id>, ctql::field<&Quote::px>, ctql::field<&Quote::qty>, ctql::field<&Quote::sym>>;
+///
+/// std::array<std::byte, ctql::encoded_size_v<QuoteWire>> buf;
+/// ctql::serialize<QuoteWire>(quote, buf);
+/// ctql::deserialize<QuoteWire>(buf, quote);
+/// @endcode
+///
+/// The wire format is the fields back to back, no padding, in `Wire` byte order
+/// (little endian by default). The encoder is generated per list:
+/// - Adjacent trivially copyable fields form a *run*. A run whose members are also
+///   adjacent in memory is copied with a single `memcpy`. Otherwise it falls back to
+///   one `memcpy` per field. Member offsets are constants, so the compiler resolves
+///   this check.
+/// - Other fields, and fields with a @ref wire_codec specialization, go through
+///   that per-type handler. A nested struct is encoded member by member by
+///   deriving its codec from @ref wire_fields.
+/// - When `Wire` differs from the host order, arithmetic and enum fields (and arrays
+///   of them) are byte-swapped in place after the copy. These are plain loops at
+///   constant offsets, which compile to `bswap` / `movbe` or vector shuffles.
+///   Any other trivially copyable field without a codec is a compile error then,
+///   since its bytes could not be put in `Wire` order.
+///
+/// `encoded_size_v` is the `Sum_v` of the field sizes and is a compile-time constant.
+
+namespace ctql {
+
+    /**
+     * @brief Per-type handler for fields that are not copied byte for byte.
+     * @tparam T The field type.
+     *
+     * @details Specialize with:
+     * - `static constexpr std::size_t size`: fixed encoded size,
+     * - `static void encode(const T&, std::byte* out)`: write exactly `size` bytes,
+     * - `static void decode(const std::byte* in, T&)`: read exactly `size` bytes.
+     *
+     * `encode` and `decode` may instead be templates on `std::endian Wire`, which then
+     * receive the byte order of the enclosing record. Needed for non-trivially copyable
+     * types, and for trivially copyable structs sent in non-native order; deriving from
+     * @ref wire_fields encodes a struct member by member.
+     */
+    template <typename T>
+    struct wire_codec;
+
+    /// @cond INTERNAL
+    namespace detail {
+        template <typename M>
+        struct member_traits;
+
+        template <typename R, typename M>
+        struct member_traits<M R::*> {
+            using record = R;
+            using type   = M;
+        };
+
+        template <typename T>
+        concept has_wire_codec = requires { wire_codec<T>::size; };
+
+        template <typename T>
+        constexpr std::size_t wire_size_of() {
+            if constexpr (has_wire_codec<T>)
+                return wire_codec<T>::size;
+            else
+                return sizeof(T);
+        }
+    } // namespace detail
+    /// @endcond
+
+    /**
+     * @brief Describe one record member for serialization.
+     * @tparam Member Pointer to data member, e.g. `&Quote::px`.
+     *
+     * @details Satisfies `HasStaticSize`: `size` is the encoded size of the member.
+     */
+    template <auto Member>
+    struct field {
+        using record = typename detail::member_traits<decltype(Member)>::record;
+        using type   = typename detail::member_traits<decltype(Member)>::type;
+
+        static constexpr auto member      = Member;
+        static constexpr bool trivial     = std::is_trivially_copyable_v<type> && !detail::has_wire_codec<type>;
+        static constexpr std::size_t size = detail::wire_size_of<type>();
+    };
+
+    /// @brief Encoded size of a field list, in bytes.
+    template <typename Fields>
+    inline constexpr std::size_t encoded_size_v = 0;
+
+    template <typename... Fs>
+    inline constexpr std::size_t encoded_size_v<detail::HTList<Fs...>> = Sum_v<Fs...>;
+
+    /// @cond INTERNAL
+    namespace detail {
+
+        // ---- byte order ----
+
+        template <typename T>
+        struct swap_unit {
+            using type = void;
+        };
+
+        template <typename T>
+            requires std::is_arithmetic_v<T> || std::is_enum_v<T>
+        struct swap_unit<T> {
+            using type = T;
+        };
+
+        template <typename T, std::size_t N>
+        struct swap_unit<T[N]> : swap_unit<T> { };
+
+        template <typename T, std::size_t N>
+        struct swap_unit<std::array<T, N>> : swap_unit<T> { };
+
+        template <std::size_t S>
+        using uint_of_size = std::conditional_t<
+            S == 2, std::uint16_t, std::conditional_t<S == 4, std::uint32_t, std::uint64_t>>;
+
+        // Reverse the byte order of every S-byte unit in [p, p + bytes).
+        template <std::size_t S>
+        inline void byteswap_units(std::byte* p, std::size_t bytes) noexcept {
+            if constexpr (S == 2 || S == 4 || S == 8) {
+                using U = uint_of_size<S>;
+                for (std::size_t at = 0; at < bytes; at += S) {
+                    U u;
+                    std::memcpy(&u, p + at, S);
+                    u = std::byteswap(u);
+                    std::memcpy(p + at, &u, S);
+                }
+            } else if constexpr (S > 1) {
+                for (std::size_t at = 0; at < bytes; at += S)
+                    for (std::size_t i = 0; i < S / 2; ++i)
+                        std::swap(p[at + i], p[at + S - 1 - i]);
+            }
+        }
+
+        // Whether T can be copied as bytes and then put in Wire order: arithmetic, enum
+        // and arrays of them in any order; anything else only in the native order.
+        template <typename T, std::endian Wire>
+        concept byte_orderable = Wire == std::endian::native || !std::is_void_v<typename swap_unit<T>::type>;
+
+        template <std::endian Wire, typename T>
+        inline void to_order(std::byte* p) noexcept {
+            static_assert(byte_orderable<T, Wire>,
+                          "serialize: a struct field in non-native byte order needs a wire_codec (e.g. wire_fields)");
+            using unit = typename swap_unit<T>::type;
+            if constexpr (Wire != std::endian::native && !std::is_void_v<unit>)
+                byteswap_units<sizeof(unit)>(p, sizeof(T));
+        }
+
+        template <std::endian Wire, typename T>
+        inline void codec_encode(const T& v, std::byte* out) {
+            if constexpr (requires { wire_codec<T>::template encode<Wire>(v, out); })
+                wire_codec<T>::template encode<Wire>(v, out);
+            else
+                wire_codec<T>::encode(v, out);
+        }
+
+        template <std::endian Wire, typename T>
+        inline void codec_decode(const std::byte* in, T& v) {
+            if constexpr (requires { wire_codec<T>::template decode<Wire>(in, v); })
+                wire_codec<T>::template decode<Wire>(in, v);
+            else
+                wire_codec<T>::decode(in, v);
+        }
+
+        // ---- runs of trivially copyable fields ----
+
+        struct run {
+            std::size_t first = 0; // index of the first field
+            std::size_t last  = 0; // index past the last field
+            bool trivial      = false;
+        };
+
+        template <std::size_t N>
+        struct run_plan {
+            std::array<run, N> runs{};
+            std::size_t len = 0;
+        };
+
+        template <std::size_t N>
+        consteval run_plan<N> plan_runs(std::array<bool, N> trivial) {
+            run_plan<N> plan;
+            for (std::size_t i = 0; i < N; ++i) {
+                if (trivial[i] && plan.len > 0 && plan.runs[plan.len - 1].trivial)
+                    plan.runs[plan.len - 1].last = i + 1;
+                else
+                    plan.runs[plan.len++] = run{i, i + 1, trivial[i]};
+            }
+            return plan;
+        }
+
+        template <typename F, typename R>
+        inline auto* address_of(R& r) noexcept {
+            using byte_t = std::conditional_t<std::is_const_v<R>, const std::byte, std::byte>;
+            return reinterpret_cast<byte_t*>(std::addressof(r.*F::member));
+        }
+
+        template <typename Fields>
+        struct codec;
+
+        template <typename... Fs>
+        struct codec<HTList<Fs...>> {
+            using list   = HTList<Fs...>;
+            using record = typename type_at_t<0, list>::record;
+
+            static_assert((std::is_same_v<typename Fs::record, record> && ...),
+                          "serialize: all fields must belong to the same record type");
+
+            static constexpr std::array<std::size_t, sizeof...(Fs)> offsets = exclusive_scan_v<Size, Fs...>;
+
+            static constexpr auto plan = plan_runs<sizeof...(Fs)>({Fs::trivial...});
+
+            template <std::size_t Run>
+            static constexpr std::size_t run_bytes
+                = offsets[plan.runs[Run].last - 1] + type_at_t<plan.runs[Run].last - 1, list>::size
+                  - offsets[plan.runs[Run].first];
+
+            // Whether every member of the run sits at its wire offset from the first
+            // one, so the wire bytes equal the object bytes. A permuted or padded run
+            // fails. Addresses are compared as integers (subtracting pointers to
+            // different members is undefined); member offsets are constants, so this folds.
+            template <std::size_t Run>
+            static bool contiguous(const record& r) noexcept {
+                constexpr run rn = plan.runs[Run];
+                const auto base  = reinterpret_cast<std::uintptr_t>(address_of<type_at_t<rn.first, list>>(r));
+                return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                    return ((reinterpret_cast<std::uintptr_t>(address_of<type_at_t<rn.first + Is, list>>(r)) - base
+                             == offsets[rn.first + Is] - offsets[rn.first])
+                            && ...);
+                }(std::make_index_sequence<rn.last - rn.first>{});
+            }
+
+            template <std::endian Wire, std::size_t Run>
+            static void encode_run(const record& r, std::byte* out) noexcept {
+                constexpr run rn = plan.runs[Run];
+                if constexpr (!rn.trivial) {
+                    using F = type_at_t<rn.first, list>;
+                    codec_encode<Wire>(r.*F::member, out + offsets[rn.first]);
+                } else {
+                    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                        if (contiguous<Run>(r))
+                            std::memcpy(out + offsets[rn.first], address_of<type_at_t<rn.first, list>>(r), run_bytes<Run>);
+                        else
+                            (std::memcpy(out + offsets[rn.first + Is],
+                                         address_of<type_at_t<rn.first + Is, list>>(r),
+                                         type_at_t<rn.first + Is, list>::size),
+                             ...);
+                        (to_order<Wire, typename type_at_t<rn.first + Is, list>::type>(out + offsets[rn.first + Is]), ...);
+                    }(std::make_index_sequence<rn.last - rn.first>{});
+                }
+            }
+
+            template <std::endian Wire, std::size_t Run>
+            static void decode_run(const std::byte* in, record& r) noexcept {
+                constexpr run rn = plan.runs[Run];
+                if constexpr (!rn.trivial) {
+                    using F = type_at_t<rn.first, list>;
+                    codec_decode<Wire>(in + offsets[rn.first], r.*F::member);
+                } else {
+                    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                        if (contiguous<Run>(r))
+                            std::memcpy(address_of<type_at_t<rn.first, list>>(r), in + offsets[rn.first], run_bytes<Run>);
+                        else
+                            (std::memcpy(address_of<type_at_t<rn.first + Is, list>>(r),
+                                         in + offsets[rn.first + Is],
+                                         type_at_t<rn.first + Is, list>::size),
+                             ...);
+                        (to_order<Wire, typename type_at_t<rn.first + Is, list>::type>(
+                             address_of<type_at_t<rn.first + Is, list>>(r)),
+                         ...);
+                    }(std::make_index_sequence<rn.last - rn.first>{});
+                }
+            }
+        };
+
+    } // namespace detail
+    /// @endcond
+
+    /**
+     * @brief Encode a record into its wire form.
+     * @tparam Fields `detail::HTList<field<...>...>` in wire order.
+     * @tparam Wire   Byte order on the wire.
+     * @param r   The record.
+     * @param out Exactly `encoded_size_v<Fields>` bytes.
+     * @returns Bytes written (`encoded_size_v<Fields>`).
+     */
+    template <typename Fields, std::endian Wire = std::endian::little, typename R>
+    std::size_t serialize(const R& r, std::span<std::byte, encoded_size_v<Fields>> out) noexcept {
+        using C = detail::codec<Fields>;
+        static_assert(std::is_same_v<R, typename C::record>, "serialize: record type does not match the field list");
+        [&]<std::size_t... Rs>(std::index_sequence<Rs...>) {
+            (C::template encode_run<Wire, Rs>(r, out.data()), ...);
+        }(std::make_index_sequence<C::plan.len>{});
+        return encoded_size_v<Fields>;
+    }
+
+    /**
+     * @brief Decode a record from its wire form.
+     * @tparam Fields `detail::HTList<field<...>...>` in wire order.
+     * @tparam Wire   Byte order on the wire.
+     * @param in Exactly `encoded_size_v<Fields>` bytes.
+     * @param r  The record to fill.
+     * @returns Bytes read (`encoded_size_v<Fields>`).
+     */
+    template <typename Fields, std::endian Wire = std::endian::little, typename R>
+    std::size_t deserialize(std::span<const std::byte, encoded_size_v<Fields>> in, R& r) noexcept {
+        using C = detail::codec<Fields>;
+        static_assert(std::is_same_v<R, typename C::record>, "deserialize: record type does not match the field list");
+        [&]<std::size_t... Rs>(std::index_sequence<Rs...>) {
+            (C::template decode_run<Wire, Rs>(in.data(), r), ...);
+        }(std::make_index_sequence<C::plan.len>{});
+        return encoded_size_v<Fields>;
+    }
+
+    /**
+     * @brief @ref wire_codec body that encodes a struct field through its own field list.
+     * @tparam Fields `detail::HTList<field<...>...>` of the nested struct.
+     *
+     * @code{.cpp}
+     * struct Px { std::uint32_t mant; std::uint16_t exp; };
+     * template <>
+     * struct ctql::wire_codec<Px> : ctql::wire_fields<CTQL_TYPE_LIST(ctql::field<&Px::mant>, ctql::field<&Px::exp>)> { };
+     * @endcode
+     */
+    template <typename Fields>
+    struct wire_fields {
+        static constexpr std::size_t size = encoded_size_v<Fields>;
+
+        template <std::endian Wire = std::endian::little, typename R>
+        static void encode(const R& r, std::byte* out) noexcept {
+            serialize<Fields, Wire>(r, std::span<std::byte, size>(out, size));
+        }
+
+        template <std::endian Wire = std::endian::little, typename R>
+        static void decode(const std::byte* in, R& r) noexcept {
+            deserialize<Fields, Wire>(std::span<const std::byte, size>(in, size), r);
+        }
+    };
+
+} // namespace ctql
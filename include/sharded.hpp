@@ -0,0 +1,192 @@
+#pragma once
+
+#include "htlist.hpp"
+#include "layout.hpp"
+#include "partition.hpp"
+#include "predicates.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <new>
+
+/// @file
+/// @brief Per-thread / per-core state without false sharing.
+/// @details
+/// `sharded_state<HTList<Fs...>, Shards>` keeps `Shards` copies of a set of
+/// counters, one per thread or core. Each field descriptor names its value type
+/// and may mark itself as written concurrently:
+///
+/// @code{.cpp}
+/// struct RxPackets { using value_type = std::uint64_t; static constexpr bool contended = true; };
+/// struct Generation { using value_type = std::uint32_t; };  // read-mostly
+/// @endcode
+///
+/// Fields are split with `partition_by_key` on @ref Contended. Every contended
+/// field gets its own `destructive_interference_size` slot; read-mostly fields are
+/// packed together by decreasing alignment (see `align_sorted_t`). Shards start on
+/// their own line, so no two shards share one.
+///
+/// All values are `std::atomic`, so `aggregate<F>()` can fold a field over every
+/// shard while writers keep running, without locks.
+///
+/// ### Example
+///
+/// @code{.cpp}
+/// ctql::sharded_state<ctql::detail::HTList<RxPackets, Generation>, 8> stats;
+/// stats.get<RxPackets>(this_core).fetch_add(1, std::memory_order_relaxed);
+/// std::uint64_t total = stats.aggregate<RxPackets>();
+/// @endcode
+
+namespace ctql {
+
+    /**
+     * @brief Minimum offset between two objects to avoid false sharing.
+     * @details Defaults to `std::hardware_destructive_interference_size` where the
+     * standard library provides it, else 64. Define `CTQL_DESTRUCTIVE_INTERFERENCE_SIZE`
+     * to pin the value, e.g. when the layout is part of an ABI.
+     */
+#if defined(CTQL_DESTRUCTIVE_INTERFERENCE_SIZE)
+    inline constexpr std::size_t destructive_interference_size = CTQL_DESTRUCTIVE_INTERFERENCE_SIZE;
+#elif defined(__cpp_lib_hardware_interference_size)
+#  if defined(__GNUC__) && !defined(__clang__)
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Winterference-size"
+#  endif
+    inline constexpr std::size_t destructive_interference_size = std::hardware_destructive_interference_size;
+#  if defined(__GNUC__) && !defined(__clang__)
+#    pragma GCC diagnostic pop
+#  endif
+#else
+    inline constexpr std::size_t destructive_interference_size = 64;
+#endif
+
+    /**
+     * @brief Key wrapper: `size` is 1 if `F::contended` is true, else 0.
+     * @tparam F Field descriptor; `contended` is optional.
+     */
+    template <typename F>
+    struct Contended {
+        using type = F;
+        static constexpr std::size_t size = [] {
+            if constexpr (requires { F::contended; })
+                return F::contended ? 1 : 0;
+            else
+                return 0;
+        }();
+    };
+
+    /// @cond INTERNAL
+    namespace detail {
+        // Contended field: one slot per interference span.
+        template <typename F>
+        struct alignas(destructive_interference_size) padded_slot {
+            std::atomic<typename F::value_type> value;
+        };
+
+        // Read-mostly field: naturally aligned, packed with its neighbours.
+        template <typename F>
+        struct packed_slot {
+            std::atomic<typename F::value_type> value;
+        };
+
+        template <typename List>
+        struct padded_block;
+
+        template <typename... Ks>
+        struct padded_block<HTList<Ks...>> {
+            using type = field_block<HTList<padded_slot<typename Ks::type>...>>;
+        };
+
+        template <typename List>
+        struct packed_block;
+
+        template <typename... Ks>
+        struct packed_block<HTList<Ks...>> {
+            using type = field_block<align_sorted_t<packed_slot<typename Ks::type>...>>;
+        };
+    } // namespace detail
+    /// @endcond
+
+    template <typename Fields, std::size_t Shards>
+    class sharded_state;
+
+    /**
+     * @brief `Shards` false-sharing-free copies of the fields @p Fs.
+     * @tparam Fs     Field descriptors exposing `using value_type` (lock-free atomics only)
+     *                and optionally `static constexpr bool contended`.
+     * @tparam Shards Number of shards, e.g. threads or cores.
+     */
+    template <typename... Fs, std::size_t Shards>
+    class sharded_state<detail::HTList<Fs...>, Shards> {
+        static_assert((std::atomic<typename Fs::value_type>::is_always_lock_free && ...),
+                      "sharded_state: field value types must be lock-free atomics");
+
+        using split = partition_by_key<SizeConst<0>, ops::gt::template pred, Contended, Fs...>;
+
+        using contended_block = typename detail::padded_block<typename split::pass>::type;
+        using shared_block    = typename detail::packed_block<typename split::fail>::type;
+
+        // The read-mostly block starts a new line; with no read-mostly fields it takes no room.
+        static constexpr std::size_t shared_align
+            = split::fail::len == 0 ? alignof(shared_block) : destructive_interference_size;
+
+    public:
+        /// @brief One shard: padded contended slots, then the packed read-mostly block.
+        struct alignas(destructive_interference_size) shard {
+            [[no_unique_address]] contended_block contended;
+            [[no_unique_address]] alignas(shared_align) shared_block shared;
+
+            /// @brief The atomic holding field @p F in this shard.
+            template <typename F>
+            std::atomic<typename F::value_type>& get() noexcept {
+                if constexpr (contended_block::template contains<detail::padded_slot<F>>)
+                    return contended.template get<detail::padded_slot<F>>().value;
+                else
+                    return shared.template get<detail::packed_slot<F>>().value;
+            }
+
+            /// @brief The atomic holding field @p F in this shard.
+            template <typename F>
+            const std::atomic<typename F::value_type>& get() const noexcept {
+                return const_cast<shard&>(*this).template get<F>();
+            }
+        };
+
+        /// @brief Number of shards.
+        static constexpr std::size_t shards = Shards;
+
+        /// @brief Shard @p i.
+        shard& operator[](std::size_t i) noexcept { return shards_[i]; }
+
+        /// @brief Shard @p i.
+        const shard& operator[](std::size_t i) const noexcept { return shards_[i]; }
+
+        /// @brief Field @p F of shard @p i.
+        template <typename F>
+        std::atomic<typename F::value_type>& get(std::size_t i) noexcept {
+            return shards_[i].template get<F>();
+        }
+
+        /**
+         * @brief Fold field @p F over all shards.
+         * @tparam Op Binary callable, as for `value_list::reduce` (default: sum).
+         * @param init Initial accumulator.
+         * @param order Memory order of each shard load.
+         *
+         * @details Lock-free: each shard is read with one atomic load, so the result
+         * is a consistent per-shard snapshot, not a global one.
+         */
+        template <typename F, typename Op = std::plus<>>
+        typename F::value_type aggregate(typename F::value_type init = {},
+                                         std::memory_order order = std::memory_order_relaxed) const noexcept {
+            for (const shard& s : shards_)
+                init = Op{}(init, s.template get<F>().load(order));
+            return init;
+        }
+
+    private:
+        std::array<shard, Shards> shards_{};
+    };
+
+} // namespace ctql
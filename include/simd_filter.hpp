@@ -0,0 +1,229 @@
+#pragma once
+
+#include "predicates.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#  define CTQL_SIMD_FILTER_X86 1
+#  include <immintrin.h>
+#else
+#  define CTQL_SIMD_FILTER_X86 0
+#endif
+
+/// @file
+/// @brief Runtime filter kernels driven by the compile-time operator tags.
+/// @details
+/// `ops::lt`, `op_type<"<="_ct>` & co. compare static `size`s in `filter_by` and
+/// `partition_by`. `filter_bitmap` and `filter_indices` apply the same tags to a
+/// column of runtime keys: key `i` is selected when `Cmp{}(keys[i], pivot)` holds,
+/// exactly as `T` passes when `Cmp{}(KeyOf<T>::size, Pivot::size)` holds.
+///
+/// Keys are processed in blocks of 64, one bitmap word per block:
+/// - `avx2`:  256-bit compares, for 4- and 8-byte keys;
+/// - `sse42`: 128-bit compares (SSE4.2 for the 64-bit integer compare);
+/// - `scalar`: a plain loop, for every other key type and CPU.
+///
+/// The kernels are compiled with per-function `target` attributes, so the library
+/// needs no `-mavx2`. `detected_simd_level()` checks the CPU once, on first use,
+/// and every call runs the widest supported kernel unless told otherwise.
+///
+/// ### Example
+///
+/// @code{.cpp}
+/// std::vector<std::uint32_t> wire_len = load_column();
+/// std::vector<std::uint32_t> rows(wire_len.size());
+///
+/// std::size_t n = ctql::filter_indices(ctql::op_type<"<="_ct>{}, 1200u, std::span{wire_len}, std::span{rows});
+/// // rows[0..n) are the positions with wire_len[i] <= 1200, ascending
+/// @endcode
+
+namespace ctql {
+
+    /// @brief Instruction set used by the filter kernels, narrowest first.
+    enum class simd_level { scalar, sse42, avx2 };
+
+    /// @brief Widest @ref simd_level this CPU supports; detected once.
+    inline simd_level detected_simd_level() noexcept {
+        static const simd_level level = [] {
+#if CTQL_SIMD_FILTER_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2"))
+                return simd_level::avx2;
+            if (__builtin_cpu_supports("sse4.2"))
+                return simd_level::sse42;
+#endif
+            return simd_level::scalar;
+        }();
+        return level;
+    }
+
+    /// @brief Key types accepted by the filter kernels.
+    template <typename T>
+    concept filter_key = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+    /// @cond INTERNAL
+    namespace detail {
+
+        struct bitmap_sink {
+            std::uint64_t* out;
+            std::size_t count = 0;
+
+            [[gnu::always_inline]] void operator()(std::size_t block, std::uint64_t word) noexcept {
+                out[block] = word;
+                count += static_cast<std::size_t>(std::popcount(word));
+            }
+        };
+
+        struct index_sink {
+            std::uint32_t* out;
+            std::size_t count = 0;
+
+            [[gnu::always_inline]] void operator()(std::size_t block, std::uint64_t word) noexcept {
+                for (; word != 0; word &= word - 1)
+                    out[count++] = static_cast<std::uint32_t>(block * 64 + std::countr_zero(word));
+            }
+        };
+
+        // Blocks first_block.. of keys[0..n), one word each, the last one partial.
+        template <typename Cmp, typename T, typename Sink>
+        void filter_scalar(const T* keys, std::size_t n, T pivot, Sink& sink, std::size_t first_block = 0) noexcept {
+            for (std::size_t b = first_block; b * 64 < n; ++b) {
+                const std::size_t len = std::min<std::size_t>(64, n - b * 64);
+                std::uint64_t word    = 0;
+                for (std::size_t i = 0; i < len; ++i)
+                    word |= std::uint64_t{Cmp{}(keys[b * 64 + i], pivot)} << i;
+                sink(b, word);
+            }
+        }
+
+#if CTQL_SIMD_FILTER_X86
+        template <typename T>
+        inline constexpr bool simd_filter_key = filter_key<T> && (sizeof(T) == 4 || sizeof(T) == 8);
+
+        // Lane-wise form of the operator tags; all-ones lanes where the relation holds.
+        // Vectors go by reference: this is inlined into kernels of different ISAs.
+        template <typename Cmp, typename V, typename M>
+        [[gnu::always_inline]] inline void vector_compare(const V& k, const V& p, M& mask) noexcept {
+            if constexpr (std::is_same_v<Cmp, less>)
+                mask = k < p;
+            else if constexpr (std::is_same_v<Cmp, less_equal>)
+                mask = k <= p;
+            else if constexpr (std::is_same_v<Cmp, greater>)
+                mask = k > p;
+            else if constexpr (std::is_same_v<Cmp, greater_equal>)
+                mask = k >= p;
+            else if constexpr (std::is_same_v<Cmp, equal_to>)
+                mask = k == p;
+            else if constexpr (std::is_same_v<Cmp, not_equal_to>)
+                mask = k != p;
+        }
+
+        template <typename Cmp>
+        inline constexpr bool has_vector_compare
+            = std::is_same_v<Cmp, less> || std::is_same_v<Cmp, less_equal> || std::is_same_v<Cmp, greater>
+              || std::is_same_v<Cmp, greater_equal> || std::is_same_v<Cmp, equal_to>
+              || std::is_same_v<Cmp, not_equal_to>;
+
+        [[gnu::target("avx2")]] inline std::uint64_t lane_bits(__m256 m) noexcept {
+            return static_cast<std::uint32_t>(_mm256_movemask_ps(m));
+        }
+        [[gnu::target("avx2")]] inline std::uint64_t lane_bits(__m256d m) noexcept {
+            return static_cast<std::uint32_t>(_mm256_movemask_pd(m));
+        }
+        [[gnu::target("sse4.2")]] inline std::uint64_t lane_bits(__m128 m) noexcept {
+            return static_cast<std::uint32_t>(_mm_movemask_ps(m));
+        }
+        [[gnu::target("sse4.2")]] inline std::uint64_t lane_bits(__m128d m) noexcept {
+            return static_cast<std::uint32_t>(_mm_movemask_pd(m));
+        }
+
+        // One kernel per instruction set: full blocks with BYTES-wide compares, the
+        // tail through filter_scalar. Each compare mask is reinterpreted as a float
+        // or double vector so one movemask collects its lane signs.
+#  define CTQL_SIMD_FILTER_KERNEL(NAME, ISA, BYTES)                                                          \
+            template <typename Cmp, typename T, typename Sink>                                                \
+            [[gnu::target(ISA)]] void NAME(const T* keys, std::size_t n, T pivot, Sink& sink) noexcept {     \
+                typedef T V __attribute__((vector_size(BYTES)));                                              \
+                typedef std::conditional_t<sizeof(T) == 4, float, double> F __attribute__((vector_size(BYTES))); \
+                constexpr std::size_t lanes = BYTES / sizeof(T);                                              \
+                const V p                   = V{} + pivot;                                                    \
+                const std::size_t blocks    = n / 64;                                                         \
+                for (std::size_t b = 0; b < blocks; ++b) {                                                    \
+                    std::uint64_t word = 0;                                                                   \
+                    for (std::size_t i = 0; i < 64; i += lanes) {                                             \
+                        V k;                                                                                  \
+                        decltype(k < p) mask;                                                                 \
+                        std::memcpy(&k, keys + b * 64 + i, sizeof k);                                         \
+                        vector_compare<Cmp>(k, p, mask);                                                      \
+                        word |= lane_bits((F)mask) << i;                                                      \
+                    }                                                                                         \
+                    sink(b, word);                                                                            \
+                }                                                                                             \
+                filter_scalar<Cmp>(keys, n, pivot, sink, blocks);                                             \
+            }
+
+        CTQL_SIMD_FILTER_KERNEL(filter_avx2, "avx2", 32)
+        CTQL_SIMD_FILTER_KERNEL(filter_sse42, "sse4.2", 16)
+
+#  undef CTQL_SIMD_FILTER_KERNEL
+#endif
+
+        template <typename Cmp, typename T, typename Sink>
+        void filter_run(const T* keys, std::size_t n, T pivot, Sink& sink, simd_level level) noexcept {
+            level = std::min(level, detected_simd_level());
+#if CTQL_SIMD_FILTER_X86
+            if constexpr (simd_filter_key<T> && has_vector_compare<Cmp>) {
+                if (level == simd_level::avx2)
+                    return filter_avx2<Cmp>(keys, n, pivot, sink);
+                if (level == simd_level::sse42)
+                    return filter_sse42<Cmp>(keys, n, pivot, sink);
+            }
+#endif
+            filter_scalar<Cmp>(keys, n, pivot, sink);
+        }
+
+    } // namespace detail
+    /// @endcond
+
+    /**
+     * @brief Selection bitmap of the keys that satisfy `Cmp{}(key, pivot)`.
+     * @param pivot Right-hand operand of every comparison.
+     * @param keys  Key column.
+     * @param bits  Output; at least `(keys.size() + 63) / 64` words. Bit `i % 64` of
+     *              word `i / 64` is set iff key `i` is selected; bits past the end are 0.
+     * @param level Widest instruction set to use; capped at `detected_simd_level()`.
+     * @returns Number of selected keys.
+     */
+    template <typename Cmp, typename T>
+        requires filter_key<std::remove_const_t<T>>
+    std::size_t filter_bitmap(op_tag<Cmp>, std::type_identity_t<std::remove_const_t<T>> pivot, std::span<T> keys,
+                              std::span<std::uint64_t> bits, simd_level level = detected_simd_level()) noexcept {
+        detail::bitmap_sink sink{bits.data()};
+        detail::filter_run<Cmp>(keys.data(), keys.size(), pivot, sink, level);
+        return sink.count;
+    }
+
+    /**
+     * @brief Positions of the keys that satisfy `Cmp{}(key, pivot)`, ascending.
+     * @param pivot Right-hand operand of every comparison.
+     * @param keys  Key column; at most 2^32 keys.
+     * @param out   Output; room for `keys.size()` positions.
+     * @param level Widest instruction set to use; capped at `detected_simd_level()`.
+     * @returns Number of positions written to @p out.
+     */
+    template <typename Cmp, typename T>
+        requires filter_key<std::remove_const_t<T>>
+    std::size_t filter_indices(op_tag<Cmp>, std::type_identity_t<std::remove_const_t<T>> pivot, std::span<T> keys,
+                               std::span<std::uint32_t> out, simd_level level = detected_simd_level()) noexcept {
+        detail::index_sink sink{out.data()};
+        detail::filter_run<Cmp>(keys.data(), keys.size(), pivot, sink, level);
+        return sink.count;
+    }
+
+} // namespace ctql
@@ -0,0 +1,256 @@
+#pragma once
+
+#include "htlist.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/// @file
+/// @brief Pool allocator whose size classes are derived from a list of types.
+/// @details
+/// `size_class_allocator<HTList<Ts...>>` serves exactly the types `Ts...`. At compile
+/// time their `sizeof` keys are sorted and grouped into size classes: walking the
+/// sizes upwards, a size joins the current class while the smallest member of the
+/// class would waste at most `MaxWastePercent` of a block, otherwise it opens a new
+/// class. `allocate<T>()` therefore knows its class statically; there is no size
+/// lookup at runtime.
+///
+/// Each class has
+/// - a per-thread free list (no atomics on the hot path), and
+/// - a global lock-free overflow stack. A thread whose list grows past
+///   `2 * Batch` blocks pushes `Batch` of them there in one CAS; a thread whose
+///   list runs dry takes the whole stack with one `exchange(nullptr)`, so the
+///   stack never pops single nodes and has no ABA problem.
+///
+/// Only when both are empty is a new chunk of `Batch` blocks taken from
+/// `::operator new`. Chunks are kept for the life of the program; blocks of a
+/// thread that exits go to the overflow stack.
+///
+/// ### Example
+///
+/// @code{.cpp}
+/// using Pool = ctql::size_class_allocator<ctql::detail::HTList<Order, Fill, Cancel, Book>>;
+///
+/// Order* o = Pool::create<Order>(id, px, qty);
+/// Pool::destroy(o);
+/// @endcode
+
+namespace ctql {
+
+    /// @cond INTERNAL
+    namespace detail {
+
+        template <std::size_t N>
+        struct size_class_plan {
+            std::array<std::size_t, N> class_of{}; // class index per input type
+            std::array<std::size_t, N> block{};    // block size per class
+            std::array<std::size_t, N> align{};    // block alignment per class
+            std::size_t classes = 0;
+        };
+
+        // Sizes are at least one pointer (a free block holds the free-list link).
+        template <std::size_t N>
+        consteval size_class_plan<N> plan_size_classes(std::array<std::size_t, N> sizes,
+                                                       std::array<std::size_t, N> aligns,
+                                                       std::size_t max_waste_percent) {
+            size_class_plan<N> plan;
+            std::array<std::size_t, N> order{};
+            for (std::size_t i = 0; i < N; ++i) {
+                order[i] = i;
+                sizes[i]  = std::max(sizes[i], sizeof(void*));
+                aligns[i] = std::max(aligns[i], alignof(void*));
+            }
+            std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return sizes[a] < sizes[b]; });
+
+            std::size_t lo = 0; // smallest size of the current class
+            for (std::size_t idx : order) {
+                const std::size_t s = sizes[idx];
+                if (plan.classes == 0 || (s - lo) * 100 > max_waste_percent * s) {
+                    lo = s;
+                    ++plan.classes;
+                }
+                const std::size_t c = plan.classes - 1;
+                plan.class_of[idx]  = c;
+                plan.block[c]       = s;
+                plan.align[c]       = std::max(plan.align[c], aligns[idx]);
+            }
+            // Round blocks up to their class alignment so consecutive blocks stay aligned.
+            for (std::size_t c = 0; c < plan.classes; ++c)
+                plan.block[c] = (plan.block[c] + plan.align[c] - 1) / plan.align[c] * plan.align[c];
+            return plan;
+        }
+
+        struct free_node {
+            free_node* next;
+        };
+
+        struct free_list {
+            free_node* head    = nullptr;
+            std::size_t length = 0;
+        };
+
+    } // namespace detail
+    /// @endcond
+
+    /**
+     * @brief Size-class pool for a fixed set of types.
+     * @tparam Types           `detail::HTList<Ts...>` of the types that will be allocated.
+     * @tparam MaxWastePercent Largest share of a block, in percent, that the smallest
+     *                         member of a size class may leave unused.
+     * @tparam Batch           Blocks per chunk, and per transfer between a thread's
+     *                         free list and the overflow stack.
+     */
+    template <typename Types, std::size_t MaxWastePercent = 25, std::size_t Batch = 64>
+    class size_class_allocator;
+
+    template <typename... Ts, std::size_t MaxWastePercent, std::size_t Batch>
+    class size_class_allocator<detail::HTList<Ts...>, MaxWastePercent, Batch> {
+        static_assert(sizeof...(Ts) > 0, "size_class_allocator: no types");
+        static_assert(MaxWastePercent < 100, "size_class_allocator: MaxWastePercent must be below 100");
+        static_assert(Batch > 0, "size_class_allocator: Batch must be positive");
+
+        using list = detail::HTList<Ts...>;
+
+        static constexpr auto plan = detail::plan_size_classes<sizeof...(Ts)>(
+            {sizeof(Ts)...}, {alignof(Ts)...}, MaxWastePercent);
+
+    public:
+        /// @brief Number of size classes.
+        static constexpr std::size_t classes = plan.classes;
+
+        /// @brief Block size of each class.
+        static constexpr std::array<std::size_t, classes> block_size = [] {
+            std::array<std::size_t, classes> out{};
+            for (std::size_t c = 0; c < classes; ++c)
+                out[c] = plan.block[c];
+            return out;
+        }();
+
+        /// @brief Block alignment of each class.
+        static constexpr std::array<std::size_t, classes> block_align = [] {
+            std::array<std::size_t, classes> out{};
+            for (std::size_t c = 0; c < classes; ++c)
+                out[c] = plan.align[c];
+            return out;
+        }();
+
+        /// @brief Size class serving @p T.
+        template <typename T>
+        static constexpr std::size_t class_of = plan.class_of[detail::index_of_v<T, list>];
+
+        /// @brief Storage for one @p T, uninitialized. Throws `std::bad_alloc` like `::operator new`.
+        template <typename T>
+            requires(detail::count_of_v<T, list> > 0)
+        [[nodiscard]] static T* allocate() {
+            return static_cast<T*>(pop<class_of<T>>());
+        }
+
+        /// @brief Return storage obtained from `allocate<T>()`.
+        template <typename T>
+            requires(detail::count_of_v<T, list> > 0)
+        static void deallocate(T* p) noexcept {
+            push<class_of<T>>(p);
+        }
+
+        /// @brief `allocate<T>()` and construct a `T` from @p args.
+        template <typename T, typename... Args>
+        [[nodiscard]] static T* create(Args&&... args) {
+            T* p = allocate<T>();
+            if constexpr (std::is_nothrow_constructible_v<T, Args...>)
+                return ::new (static_cast<void*>(p)) T(std::forward<Args>(args)...);
+            else {
+                try {
+                    return ::new (static_cast<void*>(p)) T(std::forward<Args>(args)...);
+                } catch (...) {
+                    deallocate(p);
+                    throw;
+                }
+            }
+        }
+
+        /// @brief Destroy and deallocate an object from `create<T>()`.
+        template <typename T>
+        static void destroy(T* p) noexcept {
+            p->~T();
+            deallocate(p);
+        }
+
+    private:
+        using node = detail::free_node;
+
+        // Per-thread free lists; handed to the overflow stacks when the thread exits.
+        struct local_cache {
+            std::array<detail::free_list, classes> lists{};
+
+            ~local_cache() {
+                for (std::size_t c = 0; c < classes; ++c) {
+                    if (lists[c].head == nullptr)
+                        continue;
+                    node* last = lists[c].head;
+                    while (last->next != nullptr)
+                        last = last->next;
+                    release(c, lists[c].head, last);
+                }
+            }
+        };
+
+        static inline thread_local local_cache cache_;
+        static inline std::array<std::atomic<node*>, classes> overflow_{};
+
+        // Push the chain first -> ... -> last onto the overflow stack of class c.
+        static void release(std::size_t c, node* first, node* last) noexcept {
+            last->next = overflow_[c].load(std::memory_order_relaxed);
+            while (!overflow_[c].compare_exchange_weak(last->next, first, std::memory_order_release,
+                                                       std::memory_order_relaxed)) { }
+        }
+
+        template <std::size_t C>
+        static void refill(detail::free_list& l) {
+            if (node* all = overflow_[C].exchange(nullptr, std::memory_order_acquire)) {
+                l.head   = all;
+                l.length = 0;
+                for (node* n = all; n != nullptr; n = n->next)
+                    ++l.length;
+                return;
+            }
+            constexpr std::size_t block = block_size[C];
+            auto* chunk = static_cast<std::byte*>(::operator new(block * Batch, std::align_val_t{block_align[C]}));
+            for (std::size_t i = 0; i < Batch; ++i)
+                ::new (static_cast<void*>(chunk + i * block))
+                    node{i + 1 < Batch ? reinterpret_cast<node*>(chunk + (i + 1) * block) : nullptr};
+            l.head   = reinterpret_cast<node*>(chunk);
+            l.length = Batch;
+        }
+
+        template <std::size_t C>
+        static void* pop() {
+            detail::free_list& l = cache_.lists[C];
+            if (l.head == nullptr)
+                refill<C>(l);
+            node* n = l.head;
+            l.head  = n->next;
+            --l.length;
+            return n;
+        }
+
+        template <std::size_t C>
+        static void push(void* p) noexcept {
+            detail::free_list& l = cache_.lists[C];
+            l.head               = ::new (p) node{l.head};
+            if (++l.length >= 2 * Batch) {
+                node* first = l.head;
+                node* last  = first;
+                for (std::size_t i = 1; i < Batch; ++i)
+                    last = last->next;
+                l.head = last->next;
+                l.length -= Batch;
+                release(C, first, last);
+            }
+        }
+    };
+
+} // namespace ctql
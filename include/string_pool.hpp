@@ -0,0 +1,278 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ct_string.inl>
+#include <type_traits>
+
+/// @file
+/// @brief One contiguous, deduplicated string table built from `ct_string`s.
+/// @details
+/// Every `"name"_ct` and `to_ct_string<N>()` is its own constant, so a few thousand
+/// message and field names end up scattered over rodata. `string_pool<Ss...>`
+/// packs them into one `constexpr` blob at compile time:
+///
+/// - equal strings are stored once;
+/// - a string that ends another one is stored as its tail (`"Order"` inside
+///   `"NewOrder"`), as linkers do with tail merging;
+/// - every stored string is NUL-terminated, so `c_str(i)` is usable as is;
+/// - `table[i]` is a 32-bit (offset, length) pair into `data` for the `i`-th argument;
+/// - `index` lists the arguments by the FNV-1a hash of their text, so `find` is a
+///   binary search plus one string compare rather than a scan of the table.
+///
+/// Name lookups and log formatting then read one array and two small tables.
+///
+/// ### Example
+///
+/// @code{.cpp}
+/// using names = ctql::string_pool<"NewOrder"_ct, "Order"_ct, "Cancel"_ct, "Order"_ct>;
+///
+/// static_assert(names::bytes == 16);                          // "NewOrder\0Cancel\0"
+/// static_assert(names::index_of<"Cancel"_ct> == 2);
+/// std::string_view n = names::get<std::string_view>(1);       // "Order", inside "NewOrder"
+/// std::size_t i      = names::find(wire_name.data(), wire_name.size()); // names::npos if absent
+/// @endcode
+
+namespace ctql {
+
+    /// @brief Location of one string in a @ref string_pool blob.
+    struct string_ref {
+        std::uint32_t offset = 0;
+        std::uint32_t length = 0;
+    };
+
+    /// @brief One @ref string_pool argument keyed by the FNV-1a hash of its text.
+    struct string_hash {
+        std::uint64_t hash = 0;
+        std::uint32_t at   = 0; ///< argument position
+    };
+
+    /// @cond INTERNAL
+    namespace detail {
+
+        // One argument copied into a fixed-width row: the planner then reads one local
+        // array instead of N template parameter objects, which compilers resolve slowly.
+        template <std::size_t Width>
+        struct pool_input {
+            std::array<char, Width> chars{};
+            std::size_t length = 0;
+
+            constexpr pool_input() = default;
+
+            template <std::size_t N>
+            constexpr pool_input(const ct_string<N>& s)
+                : length(N) {
+                for (std::size_t i = 0; i < N; ++i)
+                    chars[i] = s.data[i];
+            }
+        };
+
+        template <std::size_t N>
+        struct pool_plan {
+            std::array<string_ref, N> table{};
+            std::array<bool, N> stored{}; // writes its chars; the others point into one that does
+            std::size_t bytes = 0;
+        };
+
+        // Is a the tail of b?
+        template <std::size_t W>
+        constexpr bool pool_is_suffix(const pool_input<W>& a, const pool_input<W>& b) {
+            if (a.length > b.length)
+                return false;
+            for (std::size_t i = 1; i <= a.length; ++i)
+                if (a.chars[a.length - i] != b.chars[b.length - i])
+                    return false;
+            return true;
+        }
+
+        // Order by the reversed strings: a tail sorts right before the strings ending in it.
+        template <std::size_t W>
+        constexpr bool pool_reverse_less(const pool_input<W>& a, const pool_input<W>& b) {
+            for (std::size_t i = 1; i <= a.length && i <= b.length; ++i)
+                if (a.chars[a.length - i] != b.chars[b.length - i])
+                    return static_cast<unsigned char>(a.chars[a.length - i])
+                           < static_cast<unsigned char>(b.chars[b.length - i]);
+            return a.length < b.length;
+        }
+
+        // The last 8 characters, last one in the top byte: ordering by these keys agrees
+        // with pool_reverse_less except between strings that share their last 8.
+        template <std::size_t W>
+        constexpr std::uint64_t pool_tail_key(const pool_input<W>& s) {
+            std::uint64_t key = 0;
+            for (std::size_t i = 1; i <= 8; ++i)
+                key = key << 8 | (i <= s.length ? static_cast<unsigned char>(s.chars[s.length - i]) : 0u);
+            return key;
+        }
+
+        constexpr std::uint64_t pool_hash(const char* s, std::size_t n) noexcept {
+            std::uint64_t h = 0xcbf29ce484222325ull; // FNV-1a
+            for (std::size_t i = 0; i < n; ++i)
+                h = (h ^ static_cast<unsigned char>(s[i])) * 0x100000001b3ull;
+            return h;
+        }
+
+        // Positions ordered by key, ties by position. A comparison sort costs a few
+        // hundred constant-evaluation steps per compare, so this is an LSD radix sort.
+        template <std::size_t N>
+        consteval std::array<std::size_t, N> pool_radix_order(const std::array<std::uint64_t, N>& key) {
+            std::array<std::size_t, N> order{}, next{};
+            for (std::size_t i = 0; i < N; ++i)
+                order[i] = i;
+            for (unsigned shift = 0; shift < 64; shift += 8) {
+                std::array<std::size_t, 257> at{};
+                for (std::size_t i = 0; i < N; ++i)
+                    ++at[((key[i] >> shift) & 0xff) + 1];
+                for (std::size_t b = 1; b < 257; ++b)
+                    at[b] += at[b - 1];
+                for (std::size_t k = 0; k < N; ++k)
+                    next[at[(key[order[k]] >> shift) & 0xff]++] = order[k];
+                order = next;
+            }
+            return order;
+        }
+
+        // Positions of in[] ordered by pool_reverse_less, ties by position: the radix
+        // sort on the tail keys followed by an insertion sort of equal-key runs.
+        template <std::size_t N, std::size_t W>
+        consteval std::array<std::size_t, N> pool_order(const std::array<pool_input<W>, N>& in) {
+            std::array<std::uint64_t, N> key{};
+            for (std::size_t i = 0; i < N; ++i)
+                key[i] = pool_tail_key(in[i]);
+            std::array<std::size_t, N> order = pool_radix_order(key);
+            for (std::size_t k = 1; k < N; ++k)
+                for (std::size_t j = k; j > 0 && key[order[j - 1]] == key[order[j]]
+                                        && pool_reverse_less(in[order[j]], in[order[j - 1]]);
+                     --j)
+                    std::swap(order[j - 1], order[j]);
+            return order;
+        }
+
+        // Arguments by hash, equal hashes (repeats among them) by position.
+        template <std::size_t N, std::size_t W>
+        consteval std::array<string_hash, N> pool_index(const std::array<pool_input<W>, N>& in) {
+            std::array<std::uint64_t, N> key{};
+            for (std::size_t i = 0; i < N; ++i)
+                key[i] = pool_hash(in[i].chars.data(), in[i].length);
+            const std::array<std::size_t, N> order = pool_radix_order(key);
+            std::array<string_hash, N> out{};
+            for (std::size_t k = 0; k < N; ++k)
+                out[k] = {key[order[k]], static_cast<std::uint32_t>(order[k])};
+            return out;
+        }
+
+        template <std::size_t N, std::size_t W>
+        consteval pool_plan<N> plan_pool(const std::array<pool_input<W>, N>& in) {
+            pool_plan<N> plan{};
+            const std::array<std::size_t, N> by_tail = pool_order(in);
+
+            // Walk from the back: the current owner is the last string not a tail of its
+            // successor; everything before it that ends it is placed inside it.
+            std::size_t owner = N;
+            for (std::size_t k = N; k-- > 0;) {
+                const std::size_t i = by_tail[k];
+                if (owner == N || !pool_is_suffix(in[i], in[owner])) {
+                    owner           = i;
+                    plan.stored[i]  = true;
+                    plan.table[i]   = {static_cast<std::uint32_t>(plan.bytes), static_cast<std::uint32_t>(in[i].length)};
+                    plan.bytes     += in[i].length + 1;
+                } else {
+                    const string_ref& o = plan.table[owner];
+                    plan.table[i] = {static_cast<std::uint32_t>(o.offset + o.length - in[i].length),
+                                     static_cast<std::uint32_t>(in[i].length)};
+                }
+            }
+            return plan;
+        }
+
+        template <std::size_t Bytes, std::size_t N, std::size_t W>
+        consteval std::array<char, Bytes> pool_blob(const pool_plan<N>& plan, const std::array<pool_input<W>, N>& in) {
+            std::array<char, Bytes> out{};
+            for (std::size_t i = 0; i < N; ++i)
+                if (plan.stored[i])
+                    for (std::size_t c = 0; c < in[i].length; ++c)
+                        out[plan.table[i].offset + c] = in[i].chars[c];
+            return out;
+        }
+
+    } // namespace detail
+    /// @endcond
+
+    /**
+     * @brief Compile-time string table of @p Ss, deduplicated and tail-merged.
+     * @tparam Ss Strings, in lookup order; repeats are allowed and share storage.
+     */
+    template <ct_string... Ss>
+    struct string_pool {
+    private:
+        static constexpr std::size_t width = std::max({std::size_t{0}, Ss.size()...});
+
+        using inputs = std::array<detail::pool_input<width>, sizeof...(Ss)>;
+
+        // The inputs are rebuilt as temporaries: reading a large static array during
+        // constant evaluation is far slower than reading a local one.
+        static constexpr auto plan = detail::plan_pool(inputs{Ss...});
+
+        static_assert(plan.bytes <= 0xffffffffu, "string_pool: blob exceeds 32-bit offsets");
+
+    public:
+        /// @brief Number of strings (arguments, repeats included).
+        static constexpr std::size_t size = sizeof...(Ss);
+
+        /// @brief Returned by @ref find for a string that is not in the pool.
+        static constexpr std::size_t npos = size;
+
+        /// @brief Blob size in bytes, terminators included.
+        static constexpr std::size_t bytes = plan.bytes;
+
+        /// @brief The blob: each stored string followed by `'\0'`.
+        static constexpr std::array<char, bytes> data = detail::pool_blob<bytes>(plan, inputs{Ss...});
+
+        /// @brief (offset, length) of the `i`-th argument in @ref data.
+        static constexpr std::array<string_ref, size> table = plan.table;
+
+        /// @brief Every argument with its hash, by hash; equal hashes by position.
+        static constexpr std::array<string_hash, size> index = detail::pool_index(inputs{Ss...});
+
+        /// @brief Position of the first argument equal to @p S.
+        template <ct_string S>
+            requires((Ss == S) || ...)
+        static constexpr std::size_t index_of = [] {
+            constexpr std::array<bool, size> eq{(Ss == S)...};
+            return static_cast<std::size_t>(std::find(eq.begin(), eq.end(), true) - eq.begin());
+        }();
+
+        /// @brief NUL-terminated `i`-th string.
+        static constexpr const char* c_str(std::size_t i) noexcept { return data.data() + table[i].offset; }
+
+        /// @brief `i`-th string as any view constructible from `(const char*, std::size_t)`.
+        template <typename View>
+            requires std::is_constructible_v<View, const char*, std::size_t>
+        static constexpr View get(std::size_t i) {
+            return View(c_str(i), table[i].length);
+        }
+
+        /// @brief Position of the first argument equal to `[s, s + n)`, or @ref npos.
+        /// @details Binary search of @ref index on the hash of the text, then a compare
+        ///          against each argument with that hash, first position first.
+        static constexpr std::size_t find(const char* s, std::size_t n) noexcept {
+            const std::uint64_t h = detail::pool_hash(s, n);
+            auto it = std::lower_bound(index.begin(), index.end(), h,
+                                       [](const string_hash& e, std::uint64_t v) { return e.hash < v; });
+            for (; it != index.end() && it->hash == h; ++it) {
+                if (table[it->at].length != n)
+                    continue;
+                const char* p = c_str(it->at);
+                std::size_t c = 0;
+                while (c < n && p[c] == s[c])
+                    ++c;
+                if (c == n)
+                    return it->at;
+            }
+            return npos;
+        }
+    };
+
+} // namespace ctql
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <type_traits>
+
+/// @file
+/// @brief Light type-relation concepts (`is`, `is_same`, `is_conv_to`, ...).
+/// @details Only needs `<type_traits>`, so it is part of `ctql/core.hpp`. The
+/// container concepts live in `container_concepts.hpp`, function introspection
+/// in `function_traits.hpp`.
+
+namespace ctql {
+    /// @concept: wrapper for std::is_same_v
+    template <class T, class U>
+    struct is_same_or_const {
+        static constexpr bool value = false;
+    };
+
+    template <class T>
+    struct is_same_or_const<T, T> {
+        static constexpr bool value = true;
+    };
+
+    template <class T>
+    struct is_same_or_const<T, const T> {
+        static constexpr bool value = true;
+    };
+
+    template <typename T, typename U>
+    concept is_same = std::is_same_v<T, U>;
+
+#define $type_eq(T1, T2) std::is_same_v<T1, T2>
+
+    template <typename T, typename U>
+    concept is_not_same = not is_same<T, U>;
+
+    template <typename T, typename U>
+    concept is_conv_to = std::is_convertible_v<T, U>;
+
+    template <typename T, typename U>
+    concept is_not_conv_to = not is_conv_to<T, U>;
+
+    template <typename T, typename U>
+    concept is
+        = std::conditional_t<std::is_void_v<T>, std::is_void<U>, is_same_or_const<T, U>>::value;
+
+    template <typename T, typename U>
+    concept is_not = not is<T, U>;
+} // namespace ctql
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/// @file
+/// @brief `stable_type_id_v<T>`: a 64-bit type id that agrees across translation units.
+/// @details
+/// `typeid` needs RTTI and its `hash_code` may differ between runs. This id is the
+/// FNV-1a hash of the type's name as the compiler spells it, computed at compile
+/// time, so separately built objects and files written by one build and read by
+/// another agree on it. Used as the key of `section_registry` entries and in the
+/// schema hash of `column_file`.
+
+namespace ctql {
+
+    /// @cond INTERNAL
+    namespace detail {
+
+        // The compiler's spelling of T, cut out of the signature of this function.
+        template <typename T>
+        consteval auto type_signature() {
+#if defined(__clang__) || defined(__GNUC__)
+            return __PRETTY_FUNCTION__;
+#else
+            return __FUNCSIG__;
+#endif
+        }
+
+        template <typename T>
+        consteval std::uint64_t type_name_hash() {
+            const char* s = type_signature<T>();
+            std::size_t n = 0;
+            while (s[n] != '\0')
+                ++n;
+            std::size_t first = 0, last = n;
+#if defined(__clang__) || defined(__GNUC__)
+            for (std::size_t i = 0; i + 4 <= n; ++i)
+                if (s[i] == 'T' && s[i + 1] == ' ' && s[i + 2] == '=' && s[i + 3] == ' ') {
+                    first = i + 4;
+                    break;
+                }
+            int depth = 0;
+            for (last = first; last < n; ++last) {
+                const char c = s[last];
+                if (c == '<' || c == '(' || c == '[')
+                    ++depth;
+                else if ((c == '>' || c == ')' || c == ']') && depth-- == 0)
+                    break;
+                else if (c == ';' && depth == 0)
+                    break;
+            }
+#endif
+            std::uint64_t h = 0xcbf29ce484222325ull; // FNV-1a
+            for (std::size_t i = first; i < last; ++i)
+                h = (h ^ static_cast<unsigned char>(s[i])) * 0x100000001b3ull;
+            return h;
+        }
+
+    } // namespace detail
+    /// @endcond
+
+    /**
+     * @brief 64-bit id of @p T: FNV-1a of its name as the compiler spells it.
+     * @details Equal in every translation unit and every build by the same compiler;
+     *          cv-qualifiers and references are part of the name. Types in anonymous
+     *          namespaces are named `{anonymous}::X` (GCC) or `(anonymous namespace)::X`
+     *          (Clang) in every translation unit, so two such types `X` in different
+     *          translation units get the same id.
+     */
+    template <typename T>
+    inline constexpr std::uint64_t stable_type_id_v = detail::type_name_hash<T>();
+
+} // namespace ctql
@@ -0,0 +1,201 @@
+#pragma once
+
+#include "htlist.hpp"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+/// @file
+/// @brief Runtime subset of a typelist as a fixed-width bitmask.
+/// @details
+/// `type_mask<HTList<Ts...>>` stores one bit per type; the bit of `T` is its
+/// `detail::index_of_v` in the list, so every position is a compile-time constant.
+/// The bits live in `words` 64-bit words. Set operations and `count` are plain
+/// loops over those words, which the compiler unrolls and vectorizes; up to 64 types,
+/// testing whether a subscriber wants a message is a single AND.
+///
+/// ### Example
+///
+/// @code{.cpp}
+/// using Msgs = ctql::detail::HTList<Login, Ping, Quote, Trade>;
+/// using Mask = ctql::type_mask<Msgs>;
+///
+/// constexpr Mask market = Mask::of<Quote, Trade>();
+/// if (subscriber.wants.intersects(market)) { ... }
+///
+/// subscriber.wants.for_each([&]<class M>() { subscribe<M>(); });
+/// @endcode
+
+namespace ctql {
+
+    template <typename List>
+    class type_mask;
+
+    /**
+     * @brief Bitmask over the types @p Ts.
+     * @tparam Ts Types that can be members; bit `i` stands for the `i`-th type.
+     */
+    template <typename... Ts>
+    class type_mask<detail::HTList<Ts...>> {
+        using list = detail::HTList<Ts...>;
+
+    public:
+        using word_type = std::uint64_t;
+
+        /// @brief Number of types (valid bits).
+        static constexpr std::size_t size = sizeof...(Ts);
+
+        /// @brief Number of storage words.
+        static constexpr std::size_t words = (size + 63) / 64;
+
+        /// @brief Bit position of @p T.
+        template <typename T>
+        static constexpr std::size_t bit = detail::index_of_v<T, list>;
+
+        /// @brief Empty mask.
+        constexpr type_mask() noexcept = default;
+
+        /// @brief Mask of the types @p Us.
+        template <typename... Us>
+        static constexpr type_mask of() noexcept {
+            type_mask m;
+            (m.template set<Us>(), ...);
+            return m;
+        }
+
+        /// @brief Mask of the types in the sub-list @p Sub (a `detail::HTList`).
+        template <typename Sub>
+        static constexpr type_mask from() noexcept {
+            return []<typename... Us>(detail::HTList<Us...>*) {
+                return of<Us...>();
+            }(static_cast<Sub*>(nullptr));
+        }
+
+        /// @brief Mask of every type.
+        static constexpr type_mask all() noexcept { return of<Ts...>(); }
+
+        /// @brief Mask with the storage words @p w, laid out as in `data()`; bits past `size` are dropped.
+        static constexpr type_mask from_data(const std::array<word_type, words>& w) noexcept {
+            type_mask m;
+            m.bits_ = w;
+            if constexpr (size % 64 != 0)
+                m.bits_[words - 1] &= (word_type{1} << (size % 64)) - 1;
+            return m;
+        }
+
+        template <typename T>
+        constexpr type_mask& set() noexcept {
+            bits_[bit<T> / 64] |= word_type{1} << (bit<T> % 64);
+            return *this;
+        }
+
+        template <typename T>
+        constexpr type_mask& reset() noexcept {
+            bits_[bit<T> / 64] &= ~(word_type{1} << (bit<T> % 64));
+            return *this;
+        }
+
+        template <typename T>
+        constexpr bool test() const noexcept {
+            return test(bit<T>);
+        }
+
+        /// @brief Whether bit @p i is set; @p i must be below `size`.
+        constexpr bool test(std::size_t i) const noexcept { return (bits_[i / 64] >> (i % 64)) & 1; }
+
+        /// @brief Number of set bits.
+        constexpr std::size_t count() const noexcept {
+            std::size_t n = 0;
+            for (word_type w : bits_)
+                n += static_cast<std::size_t>(std::popcount(w));
+            return n;
+        }
+
+        constexpr bool any() const noexcept { return !none(); }
+
+        constexpr bool none() const noexcept {
+            word_type acc = 0;
+            for (word_type w : bits_)
+                acc |= w;
+            return acc == 0;
+        }
+
+        /// @brief Whether the two masks share a type.
+        constexpr bool intersects(const type_mask& other) const noexcept {
+            word_type acc = 0;
+            for (std::size_t i = 0; i < words; ++i)
+                acc |= bits_[i] & other.bits_[i];
+            return acc != 0;
+        }
+
+        /// @brief Whether every type of @p other is in this mask.
+        constexpr bool contains(const type_mask& other) const noexcept {
+            word_type acc = 0;
+            for (std::size_t i = 0; i < words; ++i)
+                acc |= other.bits_[i] & ~bits_[i];
+            return acc == 0;
+        }
+
+        constexpr type_mask& operator&=(const type_mask& other) noexcept {
+            for (std::size_t i = 0; i < words; ++i)
+                bits_[i] &= other.bits_[i];
+            return *this;
+        }
+
+        constexpr type_mask& operator|=(const type_mask& other) noexcept {
+            for (std::size_t i = 0; i < words; ++i)
+                bits_[i] |= other.bits_[i];
+            return *this;
+        }
+
+        constexpr type_mask& operator^=(const type_mask& other) noexcept {
+            for (std::size_t i = 0; i < words; ++i)
+                bits_[i] ^= other.bits_[i];
+            return *this;
+        }
+
+        friend constexpr type_mask operator&(type_mask l, const type_mask& r) noexcept { return l &= r; }
+        friend constexpr type_mask operator|(type_mask l, const type_mask& r) noexcept { return l |= r; }
+        friend constexpr type_mask operator^(type_mask l, const type_mask& r) noexcept { return l ^= r; }
+
+        /// @brief Complement within the `size` valid bits.
+        constexpr type_mask operator~() const noexcept {
+            type_mask out;
+            for (std::size_t i = 0; i < words; ++i)
+                out.bits_[i] = ~bits_[i];
+            if constexpr (size % 64 != 0)
+                out.bits_[words - 1] &= (word_type{1} << (size % 64)) - 1;
+            return out;
+        }
+
+        friend constexpr bool operator==(const type_mask&, const type_mask&) noexcept = default;
+
+        /// @brief The storage words; bit `i` is bit `i % 64` of word `i / 64`.
+        constexpr const std::array<word_type, words>& data() const noexcept { return bits_; }
+
+        /**
+         * @brief Call `fn.template operator()<T>()` for every set type, in list order.
+         * @details Set bits are found with `countr_zero`; each one selects its call
+         * from a table of `size` function pointers.
+         */
+        template <typename Fn>
+        constexpr void for_each(Fn&& fn) const {
+            using F = std::remove_reference_t<Fn>;
+            constexpr auto table = []<std::size_t... Is>(std::index_sequence<Is...>) {
+                return std::array<void (*)(F&), size>{
+                    +[](F& f) { f.template operator()<detail::type_at_t<Is, list>>(); }...};
+            }(std::index_sequence_for<Ts...>{});
+            for (std::size_t i = 0; i < words; ++i) {
+                for (word_type w = bits_[i]; w != 0; w &= w - 1)
+                    table[i * 64 + static_cast<std::size_t>(std::countr_zero(w))](fn);
+            }
+        }
+
+    private:
+        std::array<word_type, words> bits_{};
+    };
+
+} // namespace ctql
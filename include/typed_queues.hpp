@@ -0,0 +1,260 @@
+#pragma once
+
+#include "htlist.hpp"
+#include "sharded.hpp"
+#include "type_mask.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/// @file
+/// @brief One lock-free SPSC ring per message type, with a readiness bitmap.
+/// @details
+/// A single queue of `std::variant<Ts...>` sizes every slot for the largest
+/// alternative, and its consumer branches on the type of every item.
+/// `typed_queues<HTList<Ts...>, DepthKey>` keeps one single-producer /
+/// single-consumer ring per type instead:
+///
+/// - a `T` slot is `sizeof(T)` bytes; the ring holds `bit_ceil(DepthKey<T>::size)` of them
+///   (default key @ref QueueDepth: `T::queue_depth`, else `typed_queue_depth`);
+/// - producer and consumer indices sit on their own `destructive_interference_size`
+///   lines; the producer caches the consumer index and only reloads it when the ring
+///   looks full;
+/// - after a push the producer sets the type's bit in a readiness bitmap, a
+///   `type_mask` over `Ts...`, unless it is already set. `ready()` snapshots it and
+///   `drain(fn)` visits only the set types, handing `fn` contiguous `std::span<T>`
+///   batches of one type.
+///
+/// Each type has at most one producer thread at a time (different types may have
+/// different producers), and all types share one consumer thread.
+///
+/// ### Example
+///
+/// @code{.cpp}
+/// struct Quote { double px; std::uint32_t qty; static constexpr std::size_t queue_depth = 4096; };
+/// struct Trade { double px; std::uint32_t qty; };
+///
+/// static ctql::typed_queues<ctql::detail::HTList<Quote, Trade>> q; // rings are inline; keep it off the stack
+///
+/// q.try_push(Quote{101.5, 10});                       // producer thread(s)
+///
+/// q.drain([&]<class T>(std::span<T> batch) {          // consumer thread
+///     for (const T& m : batch) book.apply(m);         // one type per loop
+/// });
+/// @endcode
+
+namespace ctql {
+
+    /// @brief Ring depth used by @ref QueueDepth when a type does not set `queue_depth`.
+    inline constexpr std::size_t typed_queue_depth = 1024;
+
+    /**
+     * @brief Key wrapper: `size` is `T::queue_depth` if present, else `typed_queue_depth`.
+     * @tparam T Message type; `queue_depth` is optional.
+     */
+    template <typename T>
+    struct QueueDepth {
+        using type = T;
+        static constexpr std::size_t size = [] {
+            if constexpr (requires { T::queue_depth; })
+                return static_cast<std::size_t>(T::queue_depth);
+            else
+                return typed_queue_depth;
+        }();
+    };
+
+    /// @cond INTERNAL
+    namespace detail {
+
+        template <typename T, std::size_t Depth>
+        class spsc_ring {
+            static_assert(std::has_single_bit(Depth), "spsc_ring: depth must be a power of two");
+            static_assert(std::is_nothrow_destructible_v<T>, "spsc_ring: T must be nothrow destructible");
+
+        public:
+            spsc_ring() = default;
+
+            spsc_ring(const spsc_ring&)            = delete;
+            spsc_ring& operator=(const spsc_ring&) = delete;
+
+            ~spsc_ring() {
+                if constexpr (!std::is_trivially_destructible_v<T>) {
+                    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+                    for (std::size_t i = head_.load(std::memory_order_relaxed); i != tail; ++i)
+                        slot(i)->~T();
+                }
+            }
+
+            // Producer side.
+            template <typename... Args>
+            bool try_emplace(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>) {
+                const std::size_t tail = tail_.load(std::memory_order_relaxed);
+                if (tail - head_cache_ == Depth) {
+                    head_cache_ = head_.load(std::memory_order_acquire);
+                    if (tail - head_cache_ == Depth)
+                        return false;
+                }
+                ::new (static_cast<void*>(slot(tail))) T(std::forward<Args>(args)...);
+                tail_.store(tail + 1, std::memory_order_release);
+                return true;
+            }
+
+            // Consumer side: up to max items as one or two contiguous spans.
+            template <typename F>
+            std::size_t consume(F& fn, std::size_t max) {
+                const std::size_t head = head_.load(std::memory_order_relaxed);
+                const std::size_t n    = std::min(tail_.load(std::memory_order_acquire) - head, max);
+                if (n == 0)
+                    return 0;
+                const std::size_t first = head & (Depth - 1);
+                const std::size_t run   = std::min(n, Depth - first);
+                fn(std::span<T>(slot(first), run));
+                if (run < n)
+                    fn(std::span<T>(slot(0), n - run));
+                if constexpr (!std::is_trivially_destructible_v<T>)
+                    for (std::size_t i = head; i != head + n; ++i)
+                        slot(i)->~T();
+                head_.store(head + n, std::memory_order_release);
+                return n;
+            }
+
+            bool empty() const noexcept {
+                return tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_relaxed);
+            }
+
+        private:
+            T* slot(std::size_t i) noexcept {
+                return std::launder(reinterpret_cast<T*>(storage_ + (i & (Depth - 1)) * sizeof(T)));
+            }
+
+            alignas(destructive_interference_size) std::atomic<std::size_t> tail_{0};
+            std::size_t head_cache_ = 0; // producer's last view of head_
+            alignas(destructive_interference_size) std::atomic<std::size_t> head_{0};
+            alignas(destructive_interference_size) alignas(T) std::byte storage_[Depth * sizeof(T)];
+        };
+
+    } // namespace detail
+    /// @endcond
+
+    /**
+     * @brief Per-type SPSC rings over @p Types with a shared readiness bitmap.
+     * @tparam Types    `detail::HTList<Ts...>` of distinct message types.
+     * @tparam DepthKey Key wrapper giving the ring depth of each type (rounded up to a power of two).
+     */
+    template <typename Types, template <typename> class DepthKey = QueueDepth>
+    class typed_queues;
+
+    template <typename... Ts, template <typename> class DepthKey>
+    class typed_queues<detail::HTList<Ts...>, DepthKey> {
+        using list = detail::HTList<Ts...>;
+
+        static_assert(((detail::count_of_v<Ts, list> == 1) && ...), "typed_queues: types must be distinct");
+
+    public:
+        using mask_type = type_mask<list>;
+        using word_type = typename mask_type::word_type;
+
+        /// @brief Ring depth of @p T.
+        template <typename T>
+        static constexpr std::size_t depth = std::bit_ceil(std::max<std::size_t>(DepthKey<T>::size, 1));
+
+        typed_queues() = default;
+
+        typed_queues(const typed_queues&)            = delete;
+        typed_queues& operator=(const typed_queues&) = delete;
+
+        /// @brief Producer of @p T: construct a `T` from @p args; `false` if its ring is full.
+        template <typename T, typename... Args>
+            requires(detail::count_of_v<T, list> == 1)
+        bool try_emplace(Args&&... args) {
+            if (!ring<T>().try_emplace(std::forward<Args>(args)...))
+                return false;
+            mark_ready<T>();
+            return true;
+        }
+
+        /// @brief Producer of `T`: enqueue @p msg; `false` if the ring of `T` is full.
+        template <typename M, typename T = std::remove_cvref_t<M>>
+            requires(detail::count_of_v<T, list> == 1)
+        bool try_push(M&& msg) {
+            return try_emplace<T>(std::forward<M>(msg));
+        }
+
+        /// @brief Consumer: types that may have items queued.
+        mask_type ready() const noexcept {
+            std::array<word_type, mask_type::words> w{};
+            for (std::size_t i = 0; i < mask_type::words; ++i)
+                w[i] = ready_[i].load(std::memory_order_acquire);
+            return mask_type::from_data(w);
+        }
+
+        /**
+         * @brief Consumer: pass up to @p max queued `T`s to `fn(std::span<T>)`, oldest first.
+         * @details `fn` is called at most twice (the ring may wrap). The items are
+         * destroyed once it returns, so it may move from them.
+         * @returns Number of items consumed.
+         */
+        template <typename T, typename F>
+            requires(detail::count_of_v<T, list> == 1)
+        std::size_t consume(F&& fn, std::size_t max = std::numeric_limits<std::size_t>::max()) {
+            auto& r             = ring<T>();
+            const std::size_t n = r.consume(fn, max);
+            if (r.empty()) {
+                // Pairs with the fence in mark_ready: a push racing with the clear
+                // either sees the bit cleared and sets it, or is seen by empty().
+                auto& w = ready_[bit<T> / 64];
+                w.fetch_and(~mask<T>, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (!r.empty())
+                    w.fetch_or(mask<T>, std::memory_order_relaxed);
+            }
+            return n;
+        }
+
+        /**
+         * @brief Consumer: `consume` every ready type, in list order, with `fn(std::span<T>)`.
+         * @param fn          Callable for every `std::span<T>`, e.g. `[]<class T>(std::span<T>) { ... }`.
+         * @param max_per_type Cap per type, so one busy type cannot starve the others.
+         * @returns Number of items consumed.
+         */
+        template <typename F>
+        std::size_t drain(F&& fn, std::size_t max_per_type = std::numeric_limits<std::size_t>::max()) {
+            std::size_t total = 0;
+            ready().for_each([&]<class T>() { total += consume<T>(fn, max_per_type); });
+            return total;
+        }
+
+    private:
+        template <typename T>
+        static constexpr std::size_t bit = mask_type::template bit<T>;
+
+        template <typename T>
+        static constexpr word_type mask = word_type{1} << (bit<T> % 64);
+
+        template <typename T>
+        auto& ring() noexcept {
+            return std::get<detail::index_of_v<T, list>>(rings_);
+        }
+
+        template <typename T>
+        void mark_ready() noexcept {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            auto& w = ready_[bit<T> / 64];
+            if (!(w.load(std::memory_order_relaxed) & mask<T>))
+                w.fetch_or(mask<T>, std::memory_order_release);
+        }
+
+        std::tuple<detail::spsc_ring<Ts, depth<Ts>>...> rings_;
+        alignas(destructive_interference_size) std::array<std::atomic<word_type>, mask_type::words> ready_{};
+    };
+
+} // namespace ctql
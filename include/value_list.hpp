@@ -0,0 +1,196 @@
+#pragma once
+
+#include "predicates.hpp"
+#include "sorted.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+/// @file
+/// @brief Value-level counterparts of the type algorithms for NTTP packs.
+/// @details
+/// The type algorithms (`sort_list`, `partition_by`, `reduce_sizes_t`) need a
+/// wrapper type carrying `static constexpr size` for every element, which costs
+/// at least one instantiation per value. `value_list<Vs...>` keeps plain values
+/// (ports, opcodes, buffer sizes, ...) as a pack and runs the algorithms as
+/// `consteval` functions over a `std::array`, so the cost is one constant
+/// evaluation per query instead of a recursive instantiation tree.
+///
+/// ### Example
+///
+/// @code{.cpp}
+/// using L = ctql::value_list<30, 10, 20, 10>;
+///
+/// static_assert(std::is_same_v<L::sort<>, ctql::value_list<10, 10, 20, 30>>);
+/// static_assert(std::is_same_v<L::sort<>::unique<>, ctql::value_list<10, 20, 30>>);
+/// static_assert(std::is_same_v<L::partition<20, ctql::ops::lt>::pass, ctql::value_list<10, 10>>);
+/// static_assert(L::reduce<std::plus<>>() == 70);
+/// static_assert(L::to_array() == std::array{30, 10, 20, 10});
+/// @endcode
+///
+/// @note Values are converted to `value_list<Vs...>::value_type`, the common type
+///       of the pack (or `std::size_t` for an empty pack).
+
+namespace ctql {
+
+    template <auto... Vs>
+    struct value_list;
+
+    /// @cond INTERNAL
+    namespace detail {
+
+        template <typename...>
+        struct type_pack { };
+
+        template <typename T, auto>
+        using type_for = T;
+
+        // Common type of a value pack; std::size_t for the empty pack so that
+        // value_list<> still has a usable to_array(). Homogeneous packs are
+        // detected with a single is_same over two packs: both a `&&` fold and
+        // std::common_type recurse per element and do not scale to large packs.
+        template <auto... Vs>
+        struct value_type_of {
+            using type                        = std::size_t;
+            static constexpr bool homogeneous = true;
+        };
+
+        template <auto V0, auto... Vs>
+        struct value_type_of<V0, Vs...> {
+            static constexpr bool homogeneous
+                = std::is_same_v<type_pack<decltype(Vs)...>, type_pack<type_for<decltype(V0), Vs>...>>;
+
+            using type = typename std::conditional_t<
+                homogeneous,
+                std::type_identity<decltype(V0)>,
+                std::common_type<decltype(V0), decltype(Vs)...>>::type;
+        };
+
+        // Fixed-capacity result of a consteval algorithm: the first `len`
+        // entries of `data` are meaningful.
+        template <typename T, std::size_t N>
+        struct value_buffer {
+            std::array<T, N> data{};
+            std::size_t len = 0;
+        };
+
+        // value_buffer -> value_list<...> (only the first Buf.len entries).
+        template <auto Buf, typename Seq = std::make_index_sequence<Buf.len>>
+        struct from_buffer;
+
+        template <auto Buf, std::size_t... Is>
+        struct from_buffer<Buf, std::index_sequence<Is...>> {
+            using type = value_list<Buf.data[Is]...>;
+        };
+
+        template <auto Buf>
+        using from_buffer_t = typename from_buffer<Buf>::type;
+
+        template <Order Ord, typename T, std::size_t N>
+        consteval value_buffer<T, N> sort_values(std::array<T, N> in) {
+            // No comparator object: every extra call frame is paid per comparison
+            // by the constant evaluator.
+            std::sort(in.begin(), in.end());
+            if constexpr (Ord == Order::Desc)
+                std::reverse(in.begin(), in.end());
+            return {in, N};
+        }
+
+        // Keep elements where `Cmp{}(elem, pivot) == Keep` (same operand order as PredBy).
+        template <typename Cmp, bool Keep, typename T, std::size_t N>
+        consteval value_buffer<T, N> select_values(std::array<T, N> in, T pivot) {
+            value_buffer<T, N> out;
+            for (const T& v : in)
+                if (static_cast<bool>(Cmp{}(v, pivot)) == Keep)
+                    out.data[out.len++] = v;
+            return out;
+        }
+
+        template <typename T, std::size_t N>
+        consteval value_buffer<T, N> unique_values(std::array<T, N> in) {
+            value_buffer<T, N> out;
+            for (const T& v : in)
+                if (out.len == 0 || !(out.data[out.len - 1] == v))
+                    out.data[out.len++] = v;
+            return out;
+        }
+
+    } // namespace detail
+    /// @endcond
+
+    /**
+     * @brief Compile-time list of values with consteval query algorithms.
+     * @tparam Vs Values of a common (structural) type, e.g. integers or enums.
+     *
+     * @details Every algorithm returns another `value_list`, so queries chain:
+     * `L::sort<>::unique<>::to_array()`. Algorithms are member alias templates so
+     * that nothing is evaluated until a query is named.
+     */
+    template <auto... Vs>
+    struct value_list {
+        /// @brief Element type: common type of `Vs...` (`std::size_t` if empty).
+        using value_type = typename detail::value_type_of<Vs...>::type;
+
+        /// @brief Number of values.
+        static constexpr std::size_t len = sizeof...(Vs);
+
+        /// @brief Materialize the pack as a `std::array`.
+        static consteval std::array<value_type, len> to_array() {
+            // A per-element cast is instantiated once per value; skip it when no
+            // conversion is needed so that large packs stay cheap.
+            if constexpr (detail::value_type_of<Vs...>::homogeneous)
+                return {Vs...};
+            else
+                return {static_cast<value_type>(Vs)...};
+        }
+
+        /**
+         * @brief Values sorted in order @p Ord.
+         * @complexity One constant evaluation, O(n log n) steps.
+         */
+        template <Order Ord = Order::Asc>
+        using sort = detail::from_buffer_t<detail::sort_values<Ord>(to_array())>;
+
+        /**
+         * @brief Split on a pivot value with an operator tag from @ref ops.
+         * @tparam Pivot Pivot value.
+         * @tparam Op    Operator tag (e.g. `ops::lt`, `op_type<"<="_ct>`); its comparator
+         *               is applied as `(elem, Pivot)`, matching `PredBy`.
+         *
+         * @details `pass` holds the values satisfying the relation, `fail` the rest;
+         * both keep the original order.
+         */
+        template <auto Pivot, typename Op>
+        struct partition {
+            using pass = detail::from_buffer_t<detail::select_values<typename Op::compare, true>(
+                to_array(), static_cast<value_type>(Pivot))>;
+            using fail = detail::from_buffer_t<detail::select_values<typename Op::compare, false>(
+                to_array(), static_cast<value_type>(Pivot))>;
+        };
+
+        /// @brief Values satisfying `Op` against @p Pivot (see @ref partition).
+        template <auto Pivot, typename Op>
+        using filter = typename partition<Pivot, Op>::pass;
+
+        /// @brief Drop consecutive duplicates, like `std::unique` (sort first for set semantics).
+        template <typename = void>
+        using unique = detail::from_buffer_t<detail::unique_values(to_array())>;
+
+
+        /**
+         * @brief Left fold of the values with a binary callable.
+         * @tparam Op   Default-constructible binary callable, e.g. `std::plus<>`.
+         * @tparam Init Initial accumulator (defaults to a value-initialized `value_type`).
+         */
+        template <typename Op, auto Init = value_type{}>
+        static consteval auto reduce() {
+            auto acc = Init;
+            for (const value_type& v : to_array())
+                acc = Op{}(acc, v);
+            return acc;
+        }
+    };
+
+} // namespace ctql
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "htlist.hpp"
+#include "predicates.hpp"
+#include "reduce.hpp"
+#include "serialize.hpp"
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+/// @file
+/// @brief Zero-copy typed view over a packed wire record.
+/// @details
+/// `wire_view<Ts...>` wraps the bytes of a record whose fields `Ts...` are stored
+/// back to back (no padding), as produced by `serialize`. Field offsets come from
+/// `exclusive_scan_v<SizeOf, Ts...>`, so `get<I>()` is a single load at a
+/// compile-time offset. The bytes are never parsed or copied into a struct.
+///
+/// ### Example
+///
+/// @code{.cpp}
+/// using QuoteView = ctql::wire_view<std::uint64_t, std::uint32_t, std::uint16_t>;
+///
+/// void on_packet(std::span<const std::byte> pkt) {
+///     QuoteView q{pkt.first<QuoteView::size>()};
+///     std::uint32_t px = q.get<1>();
+/// }
+/// @endcode
+///
+/// @note Fields must be trivially copyable. Arithmetic and enum fields (and arrays of
+///       them) are converted from the wire byte order (little endian by default).
+///       `get<I>()` returns by value; a C array field, or one that is not default
+///       constructible, is read with `get<I>(out)`. Other fields (e.g. structs) cannot
+///       be put in a foreign byte order, so `get` is only available for them when
+///       `Wire` is the native order.
+
+namespace ctql {
+
+    /**
+     * @brief Typed read-only view of a packed record in @p Wire byte order.
+     * @tparam Wire Byte order of the underlying bytes.
+     * @tparam Ts   Field types in wire order.
+     */
+    template <std::endian Wire, typename... Ts>
+    class basic_wire_view {
+        static_assert((std::is_trivially_copyable_v<Ts> && ...),
+                      "wire_view: fields must be trivially copyable");
+
+        using list = detail::HTList<Ts...>;
+
+    public:
+        /// @brief Encoded record size in bytes.
+        static constexpr std::size_t size = Sum_v<SizeOf<Ts>...>;
+
+        /// @brief Byte offset of each field.
+        static constexpr auto offsets = exclusive_scan_v<SizeOf, Ts...>;
+
+        /// @brief Type of field @p I.
+        template <std::size_t I>
+        using field_type = detail::type_at_t<I, list>;
+
+        /// @brief View @p bytes; no copy is made.
+        constexpr explicit basic_wire_view(std::span<const std::byte, size> bytes) noexcept
+            : bytes_(bytes) { }
+
+        /// @brief Read field @p I by value; C array fields are read with the out-parameter overload.
+        template <std::size_t I>
+            requires(!std::is_array_v<field_type<I>> && std::is_default_constructible_v<field_type<I>>
+                     && detail::byte_orderable<field_type<I>, Wire>)
+        field_type<I> get() const noexcept {
+            field_type<I> v;
+            get<I>(v);
+            return v;
+        }
+
+        /// @brief Read field @p I into @p out; works for any field, C arrays included.
+        template <std::size_t I>
+            requires detail::byte_orderable<field_type<I>, Wire>
+        void get(field_type<I>& out) const noexcept {
+            std::memcpy(&out, bytes_.data() + offsets[I], sizeof(out));
+            detail::to_order<Wire, field_type<I>>(reinterpret_cast<std::byte*>(&out));
+        }
+
+        /// @brief The underlying bytes.
+        constexpr std::span<const std::byte, size> bytes() const noexcept { return bytes_; }
+
+    private:
+        std::span<const std::byte, size> bytes_;
+    };
+
+    /// @brief @ref basic_wire_view over little-endian bytes, the `serialize` default.
+    template <typename... Ts>
+    using wire_view = basic_wire_view<std::endian::little, Ts...>;
+
+} // namespace ctql
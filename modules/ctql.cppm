@@ -0,0 +1,202 @@
+// ctql/modules/ctql.cppm
+//
+// C++20 named module wrapping the header library: `import ctql;`.
+// Built only with -DCTQL_BUILD_MODULE=ON (see CMakeLists.txt).
+//
+// Macros cannot cross a module boundary; TUs that want the CTQL_* / `$...`
+// shorthands still `#include <include/macros.hpp>` next to the import.
+// Keep the export list in sync with the public names of the headers.
+
+module;
+
+#define CTQL_NO_MACROS
+#include <ctql.hpp>
+#include <include/column_file.hpp>
+
+export module ctql;
+
+export namespace ctql {
+    namespace detail {
+        using ctql::detail::append;
+        using ctql::detail::count_of_v;
+        using ctql::detail::HTList;
+        using ctql::detail::index_of;
+        using ctql::detail::index_of_v;
+        using ctql::detail::type_at;
+        using ctql::detail::type_at_t;
+        using ctql::detail::unwrap;
+        using ctql::detail::unwrap_t;
+    } // namespace detail
+
+    // type_concepts.hpp, container_concepts.hpp, function_traits.hpp, extract.hpp
+    using ctql::function_traits;
+    using ctql::get_nth_argument_t;
+    using ctql::is;
+    using ctql::is_array;
+    using ctql::is_bits_array;
+    using ctql::is_complex;
+    using ctql::is_conv_to;
+    using ctql::is_function_with_signature;
+    using ctql::is_map;
+    using ctql::is_not;
+    using ctql::is_not_conv_to;
+    using ctql::is_not_same;
+    using ctql::is_pair;
+    using ctql::is_same;
+    using ctql::is_same_or_const;
+    using ctql::is_set;
+    using ctql::is_std_array;
+    using ctql::is_tuple;
+    using ctql::is_vector;
+    using ctql::to_tuple;
+    using ctql::to_variant;
+
+    // ct_string.inl, match.hpp
+    using ctql::count_digits;
+    using ctql::ct_string;
+    using ctql::foreach_indexed;
+    using ctql::match;
+    using ctql::to_ct_string;
+    using ctql::operator+;
+    using ctql::operator==;
+    using ctql::operator""_ct;
+    using ctql::case_;
+    using ctql::default_;
+    using ctql::match_t;
+
+    // predicates.hpp
+    using ctql::AlignOf;
+    using ctql::AlignOf_t;
+    using ctql::Apply;
+    using ctql::cmp;
+    using ctql::HasStaticSize;
+    using ctql::op_tag;
+    using ctql::op_type;
+    using ctql::ops;
+    using ctql::PredBy;
+    using ctql::Size;
+    using ctql::Size_t;
+    using ctql::SizeConst;
+    using ctql::SizeOf;
+    using ctql::SizeOf_t;
+
+    // sorted.hpp, partition.hpp, reduce.hpp, select.hpp, value_list.hpp
+    using ctql::Order;
+    using ctql::sort_list;
+    using ctql::TypeSort;
+    using ctql::filter_by;
+    using ctql::partition_by;
+    using ctql::partition_by_key;
+    using ctql::reject_if_by;
+    using ctql::exclusive_scan_t;
+    using ctql::exclusive_scan_v;
+    using ctql::reduce_sizes_t;
+    using ctql::reduce_sizes_v;
+    using ctql::Sum;
+    using ctql::Sum_v;
+    using ctql::Min;
+    using ctql::Min_v;
+    using ctql::Max;
+    using ctql::Max_v;
+    using ctql::min_by_t;
+    using ctql::max_by_t;
+    using ctql::nth_t;
+    using ctql::top_k_t;
+    using ctql::value_list;
+
+    // bin_pack.hpp, layout.hpp, hot_cold.hpp, sharded.hpp
+    using ctql::bin;
+    using ctql::bin_pack;
+    using ctql::bin_pack_t;
+    using ctql::build_frame;
+    using ctql::align_sorted_t;
+    using ctql::field_block;
+    using ctql::cache_line_size;
+    using ctql::hot_cold_split;
+    using ctql::Contended;
+    using ctql::destructive_interference_size;
+    using ctql::sharded_state;
+
+    // serialize.hpp, wire_view.hpp
+    using ctql::deserialize;
+    using ctql::encoded_size_v;
+    using ctql::field;
+    using ctql::serialize;
+    using ctql::wire_codec;
+    using ctql::basic_wire_view;
+    using ctql::wire_view;
+
+    // dispatch.hpp
+    using ctql::dispatcher;
+    using ctql::make_dispatcher;
+    using ctql::message_id;
+
+    // inplace_function.hpp
+    using ctql::inplace_align_v;
+    using ctql::inplace_capacity_v;
+    using ctql::inplace_function;
+    using ctql::inplace_function_capacity;
+    using ctql::inplace_function_for;
+
+    // size_class_allocator.hpp
+    using ctql::size_class_allocator;
+
+    // type_mask.hpp
+    using ctql::type_mask;
+
+    // classifier.hpp
+    using ctql::classifier;
+
+    // query.hpp
+    using ctql::query;
+
+    // simd_filter.hpp
+    using ctql::simd_level;
+    using ctql::detected_simd_level;
+    using ctql::filter_key;
+    using ctql::filter_bitmap;
+    using ctql::filter_indices;
+
+    // match_dispatch.hpp
+    using ctql::match_dispatch;
+    using ctql::match_linear_max;
+    using ctql::match_strategy;
+    using ctql::match_strategy_v;
+
+    // typed_queues.hpp
+    using ctql::QueueDepth;
+    using ctql::typed_queue_depth;
+    using ctql::typed_queues;
+
+    // batch_dispatch.hpp
+    using ctql::batch_dispatch;
+    using ctql::batch_dispatch_in_place;
+
+    // string_pool.hpp
+    using ctql::string_ref;
+    using ctql::string_hash;
+    using ctql::string_pool;
+
+    // binary_log.hpp
+    using ctql::format_spec;
+    using ctql::log_argument;
+    using ctql::log_ring;
+
+    // flat_tuple.hpp
+    using ctql::flat_apply;
+    using ctql::flat_tuple;
+    using ctql::get;
+
+    // type_id.hpp
+    using ctql::stable_type_id_v;
+
+    // section_registry.hpp (the registration macros need #include)
+    using ctql::registry_entry;
+    using ctql::section_registry;
+
+#if __has_include(<sys/mman.h>)
+    // column_file.hpp (opt-in for header users; its POSIX headers stay in this fragment)
+    using ctql::column_file;
+    using ctql::column_file_error;
+#endif
+} // namespace ctql
@@ -0,0 +1,25 @@
+// Compiles against ctql/core.hpp alone: the algorithms must not depend on the
+// opt-in headers, and must not drag the heavy standard headers back in.
+#include <ctql/core.hpp>
+
+#if defined(__GLIBCXX__)
+#  if defined(_GLIBCXX_FUNCTIONAL) || defined(_GLIBCXX_MAP) || defined(_GLIBCXX_SET) \
+      || defined(_GLIBCXX_COMPLEX) || defined(_GLIBCXX_VARIANT) || defined(_GLIBCXX_STRING_VIEW)
+#    error "ctql/core.hpp pulls in a heavy standard header"
+#  endif
+#endif
+
+namespace core_only {
+    struct A { static constexpr std::size_t size = 3; };
+    struct B { static constexpr std::size_t size = 1; };
+    struct C { static constexpr std::size_t size = 2; };
+
+    using namespace ctql;
+
+    static_assert(std::is_same_v<TypeSort<Order::Asc, Size, A, B, C>, Size_t<B, C, A>>);
+    static_assert(std::is_same_v<filter_by<SizeConst<2>, ops::leq::template pred, A, B, C>, detail::HTList<B, C>>);
+    static_assert(Sum_v<A, B, C> == 6);
+    static_assert(std::is_same_v<max_by_t<Size, A, B, C>, A> && std::is_same_v<nth_t<1, Size, A, B, C>, C>);
+    static_assert(exclusive_scan_v<Size, A, B, C>[2] == 4);
+    static_assert(ops::lt::compare{}(1, 2) && !ops::geq::compare{}(1, 2));
+} // namespace core_only
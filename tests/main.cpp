@@ -1,9 +1,112 @@
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
 #include <ctql.hpp>
+#include <include/column_file.hpp>
+#include <tests/registry.hpp>
 #include <tests/test.hpp>
 
 using namespace ctql;
 
+struct Unhandled { };
+
+namespace {
+    std::uint64_t filled = 0, cancelled = 0, audited = 0;
+
+    void on_fill(const Fill& f) { filled += f.qty; }
+    void on_cancel(const Cancel& c) { cancelled = c.order; }
+    void audit_fill(const Fill&) { ++audited; }
+} // namespace
+
+CTQL_REGISTER_HANDLER(test_handlers, Fill, on_fill);
+CTQL_REGISTER_HANDLER(test_handlers, Cancel, on_cancel);
+CTQL_REGISTER_HANDLER(test_handlers, Fill, audit_fill);
+
+struct Small { static constexpr std::size_t size = 2; };
+struct Large { static constexpr std::size_t size = 3; };
+struct Mid   { static constexpr std::size_t size = 2; };
+
+struct Hot  { int v;  static constexpr std::size_t heat = 9; };
+struct Cold { long v; static constexpr std::size_t heat = 0; };
+
+struct Hits  { using value_type = std::uint64_t; static constexpr bool contended = true; };
+struct Epoch { using value_type = std::uint32_t; };
+
+struct Symbol {
+    std::string name;
+};
+
+template <>
+struct ctql::wire_codec<Symbol> {
+    static constexpr std::size_t size = 4;
+    static void encode(const Symbol& s, std::byte* out) {
+        std::memset(out, 0, size);
+        std::memcpy(out, s.name.data(), std::min(s.name.size(), size));
+    }
+    static void decode(const std::byte* in, Symbol& s) {
+        s.name.assign(reinterpret_cast<const char*>(in), size);
+        s.name.resize(s.name.find('\0') == std::string::npos ? size : s.name.find('\0'));
+    }
+};
+
+struct Quote {
+    std::uint64_t id;
+    std::uint32_t px;
+    std::uint16_t qty;
+    std::uint16_t flags;
+    Symbol sym;
+    std::uint32_t seq;
+};
+
+using QuoteWire = CTQL_TYPE_LIST(
+    field<&Quote::id>, field<&Quote::px>, field<&Quote::qty>, field<&Quote::flags>,
+    field<&Quote::sym>, field<&Quote::seq>);
+
+struct Mantissa { std::uint32_t mant; std::uint16_t exp; std::uint16_t pad; };
+struct Priced { std::uint32_t id; Mantissa px; };
+
+// Mantissa is trivially copyable; its codec puts each member in the record's byte order.
+template <>
+struct ctql::wire_codec<Mantissa>
+    : wire_fields<CTQL_TYPE_LIST(field<&Mantissa::mant>, field<&Mantissa::exp>, field<&Mantissa::pad>)> { };
+
+using PricedWire = CTQL_TYPE_LIST(field<&Priced::id>, field<&Priced::px>);
+
+struct Quad { std::uint32_t a, b, c, d; };
+
+// Trivially copyable throughout, but b and c trade places on the wire.
+using QuadWire = CTQL_TYPE_LIST(field<&Quad::a>, field<&Quad::c>, field<&Quad::b>, field<&Quad::d>);
+
+struct Login { static constexpr std::uint16_t id = 3; std::uint64_t user; };
+struct Ping  { static constexpr std::uint16_t id = 5; std::uint32_t seq; };
+struct Tag   { static constexpr std::uint16_t id = 4; Symbol sym; };
+struct Fills { static constexpr std::uint16_t id = 6; std::uint8_t side; std::uint32_t qty; }; // 3 bytes of padding
+
+template <>
+struct ctql::wire_codec<Fills> : wire_fields<CTQL_TYPE_LIST(field<&Fills::side>, field<&Fills::qty>)> { };
+
+struct Tick  { std::uint32_t v; static constexpr std::size_t queue_depth = 8; };
+struct Label { std::string name; };
+
+template <>
+struct ctql::wire_codec<Tag> : ctql::wire_codec<Symbol> {
+    static void decode(const std::byte* in, Tag& t) { wire_codec<Symbol>::decode(in, t.sym); }
+};
+
+template <class F>
+struct HeatOf {
+    using type = F;
+    static constexpr std::size_t size = F::heat;
+};
+
 int main() {
     Test::initialize();
     
@@ -15,5 +118,503 @@ int main() {
         ) == 13);
     });
 
-    return 0;
+    Test::test("bin_pack frames", []() {
+        using Frames = bin_pack<4, Size, Small, Large, Mid>;
+        static_assert(Frames::bins == 2);
+
+        std::vector<std::vector<std::byte>> sent;
+        Frames::emit(
+            []<class T>(std::span<std::byte> dst) {
+                for (auto& b : dst)
+                    b = std::byte{T::size};
+            },
+            [&](std::span<const std::byte> frame) { sent.emplace_back(frame.begin(), frame.end()); });
+
+        using B = std::byte;
+        Test::assert_that(sent.size() == 2);
+        Test::assert_that(sent[0] == std::vector<B>{B{3}, B{3}, B{3}});
+        Test::assert_that(sent[1] == std::vector<B>{B{2}, B{2}, B{2}, B{2}});
+    });
+
+    Test::test("hot_cold_split accessors", []() {
+        using Split = hot_cold_split<CTQL_TYPE_LIST(Hot, Cold), HeatOf, 5>;
+
+        Split::cold_type cold{};
+        Split::hot_type hot{};
+        hot.link(cold);
+        hot.get<Hot>().v  = 1;
+        hot.get<Cold>().v = 2;
+
+        Test::assert_that(cold.get<Cold>().v == 2);
+        Test::assert_that(Split::get<Hot>(hot, cold).v == 1);
+        Test::assert_that(Split::get<Cold>(hot, cold).v == 2);
+    });
+
+    Test::test("sharded_state aggregate", []() {
+        sharded_state<CTQL_TYPE_LIST(Hits, Epoch), 3> state;
+        for (std::size_t i = 0; i < state.shards; ++i) {
+            state.get<Hits>(i).fetch_add(i + 1, std::memory_order_relaxed);
+            state[i].get<Epoch>().store(static_cast<std::uint32_t>(10 * i));
+        }
+
+        Test::assert_that(state.aggregate<Hits>() == 6);
+        Test::assert_that(state.aggregate<Epoch>(0, std::memory_order_acquire) == 30);
+        using Max = decltype([](auto a, auto b) { return a < b ? b : a; });
+        Test::assert_that(state.aggregate<Epoch, Max>() == 20);
+    });
+
+    Test::test("serialize round trip", []() {
+        static_assert(encoded_size_v<QuoteWire> == 8 + 4 + 2 + 2 + 4 + 4);
+
+        Quote in{0x0102030405060708, 0x0A0B0C0D, 7, 9, {"AAPL"}, 42};
+        std::array<std::byte, encoded_size_v<QuoteWire>> buf{};
+        Test::assert_that(serialize<QuoteWire>(in, buf) == buf.size());
+
+        Quote out{};
+        deserialize<QuoteWire>(buf, out);
+        Test::assert_that(out.id == in.id && out.px == in.px && out.qty == in.qty && out.flags == in.flags);
+        Test::assert_that(out.sym.name == "AAPL" && out.seq == 42);
+    });
+
+    Test::test("serialize keeps wire order of permuted members", []() {
+        const Quad in{1, 2, 3, 4};
+        std::array<std::byte, encoded_size_v<QuadWire>> buf{};
+        serialize<QuadWire>(in, buf);
+
+        std::array<std::uint32_t, 4> words{};
+        std::memcpy(words.data(), buf.data(), buf.size());
+        if constexpr (std::endian::native == std::endian::little)
+            Test::assert_that(words == std::array<std::uint32_t, 4>{1, 3, 2, 4});
+
+        Quad out{};
+        deserialize<QuadWire>(buf, out);
+        Test::assert_that(out.a == 1 && out.b == 2 && out.c == 3 && out.d == 4);
+    });
+
+    Test::test("serialize big endian nested struct", []() {
+        static_assert(encoded_size_v<PricedWire> == 12 && !field<&Priced::px>::trivial);
+        const Priced in{0x01020304, {0x0A0B0C0D, 0x1122, 0}};
+        std::array<std::byte, encoded_size_v<PricedWire>> buf{};
+        serialize<PricedWire, std::endian::big>(in, buf);
+
+        using B = std::byte;
+        Test::assert_that(buf[0] == B{0x01} && buf[3] == B{0x04});
+        Test::assert_that(buf[4] == B{0x0A} && buf[7] == B{0x0D} && buf[8] == B{0x11} && buf[9] == B{0x22});
+
+        Priced out{};
+        deserialize<PricedWire, std::endian::big>(buf, out);
+        Test::assert_that(out.id == in.id && out.px.mant == in.px.mant && out.px.exp == in.px.exp);
+    });
+
+    Test::test("serialize big endian", []() {
+        Quote in{0x0102030405060708, 0x0A0B0C0D, 0x1122, 0x3344, {"IBM"}, 1};
+        std::array<std::byte, encoded_size_v<QuoteWire>> buf{};
+        serialize<QuoteWire, std::endian::big>(in, buf);
+
+        using B = std::byte;
+        Test::assert_that(buf[0] == B{0x01} && buf[7] == B{0x08});
+        Test::assert_that(buf[8] == B{0x0A} && buf[11] == B{0x0D});
+        Test::assert_that(buf[12] == B{0x11} && buf[14] == B{0x33});
+        Test::assert_that(buf[16] == B{'I'} && buf[19] == B{0} && buf[23] == B{1});
+
+        Quote out{};
+        deserialize<QuoteWire, std::endian::big>(buf, out);
+        Test::assert_that(out.id == in.id && out.px == in.px && out.qty == in.qty && out.flags == in.flags);
+        Test::assert_that(out.sym.name == "IBM" && out.seq == 1);
+    });
+
+    Test::test("wire_view reads serialized fields", []() {
+        Quote in{0x0102030405060708, 0x0A0B0C0D, 0x1122, 0x3344, {"X"}, 5};
+        std::array<std::byte, encoded_size_v<QuoteWire>> le{}, be{};
+        serialize<QuoteWire>(in, le);
+        serialize<QuoteWire, std::endian::big>(in, be);
+
+        using Head = wire_view<std::uint64_t, std::uint32_t, std::uint16_t, std::uint16_t>;
+        static_assert(Head::size == 16 && Head::offsets[3] == 14);
+
+        Head h{std::span<const std::byte>(le).first<Head::size>()};
+        Test::assert_that(h.get<0>() == in.id && h.get<1>() == in.px);
+        Test::assert_that(h.get<2>() == in.qty && h.get<3>() == in.flags);
+
+        basic_wire_view<std::endian::big, std::uint64_t, std::uint32_t> hb{std::span<const std::byte>(be).first<12>()};
+        Test::assert_that(hb.get<0>() == in.id && hb.get<1>() == in.px);
+
+        // Array fields are read through the out parameter, byte-swapped per element.
+        using Words = basic_wire_view<std::endian::big, std::uint32_t[2], std::uint16_t>;
+        std::uint32_t words[2];
+        Words{std::span<const std::byte>(be).subspan<4, Words::size>()}.get<0>(words);
+        Test::assert_that(words[0] == 0x05060708 && words[1] == 0x0A0B0C0D);
+    });
+
+    Test::test("dispatcher routes by id", []() {
+        std::uint64_t user = 0;
+        std::uint32_t seq  = 0;
+        std::string sym;
+        auto d = make_dispatcher<CTQL_TYPE_LIST(Ping, Login, Tag)>(
+            [&](const Login& m) { user = m.user; },
+            [&](Ping m) { seq = m.seq; },
+            [&](const Tag& m) { sym = m.sym.name; });
+        static_assert(std::is_same_v<decltype(d)::messages, CTQL_TYPE_LIST(Login, Ping, Tag)>);
+        static_assert(decltype(d)::min_id == 3 && decltype(d)::table_size == 3);
+
+        const Login sent{.user = 42};
+        std::array<std::byte, sizeof(Login)> login{};
+        std::memcpy(login.data(), &sent, sizeof(Login));
+        Test::assert_that(d.dispatch(Login::id, login) && user == 42);
+
+        const char tag[] = {'A', 'B', 0, 0};
+        Test::assert_that(d.dispatch(Tag::id, std::as_bytes(std::span(tag))) && sym == "AB");
+
+        d(Ping{9});
+        Test::assert_that(seq == 9);
+        Test::assert_that(!d.dispatch(2, login) && !d.dispatch(6, login));
+        Test::assert_that(!d.dispatch(Ping::id, std::span(login).first(2)));
+
+        // A padded message with a codec takes the serialize wire form, not its object image.
+        std::uint32_t qty = 0;
+        auto packed = make_dispatcher<CTQL_TYPE_LIST(Fills)>([&](const Fills& m) { qty = m.side == 'S' ? m.qty : 0; });
+        std::array<std::byte, encoded_size_v<CTQL_TYPE_LIST(field<&Fills::side>, field<&Fills::qty>)>> wire{};
+        serialize<CTQL_TYPE_LIST(field<&Fills::side>, field<&Fills::qty>)>(Fills{'S', 250}, wire);
+        Test::assert_that(wire.size() == 5 && packed.dispatch(Fills::id, wire) && qty == 250);
+    });
+
+    Test::test("inplace_function stores, copies and moves", []() {
+        std::string seen;
+        auto append = [&seen, suffix = std::string("!")](const std::string& s) { seen += s + suffix; };
+        using Fn    = inplace_function_for<void(const std::string&), decltype(append)>;
+
+        Fn f = append;
+        Test::assert_that(static_cast<bool>(f));
+        f("a");
+        Fn g = f;
+        g("b");
+        Fn h = std::move(f);
+        h("c");
+        Test::assert_that(!f && seen == "a!b!c!");
+
+        inplace_function<int(int) noexcept> twice = [](int x) noexcept { return 2 * x; };
+        Test::assert_that(twice(21) == 42);
+        twice = nullptr;
+        Test::assert_that(twice == nullptr);
+    });
+
+    Test::test("size_class_allocator reuses blocks", []() {
+        using Pool = size_class_allocator<CTQL_TYPE_LIST(Quote, Login, Ping), 25, 4>;
+
+        std::vector<Login*> logins;
+        for (std::uint64_t i = 0; i < 20; ++i)
+            logins.push_back(Pool::create<Login>(Login{.user = i}));
+        for (std::uint64_t i = 0; i < 20; ++i)
+            Test::assert_that(logins[i]->user == i);
+        for (Login* l : logins)
+            Pool::destroy(l); // spills to the overflow stack past 2 * Batch
+
+        std::vector<Login*> again;
+        for (int i = 0; i < 20; ++i)
+            again.push_back(Pool::allocate<Login>());
+        std::sort(logins.begin(), logins.end());
+        std::sort(again.begin(), again.end());
+        Test::assert_that(logins == again);
+        for (Login* l : again)
+            Pool::deallocate(l);
+
+        Quote* q = Pool::create<Quote>(Quote{.id = 1, .px = 0, .qty = 0, .flags = 0, .sym = {"IBM"}, .seq = 0});
+        Test::assert_that(reinterpret_cast<std::uintptr_t>(q) % alignof(Quote) == 0 && q->sym.name == "IBM");
+        Pool::destroy(q);
+    });
+
+    Test::test("type_mask visits set types", []() {
+        using Wide = CTQL_TYPE_LIST(
+            std::array<char, 0>, std::array<char, 1>, std::array<char, 2>, std::array<char, 3>, std::array<char, 4>,
+            std::array<char, 5>, std::array<char, 6>, std::array<char, 7>, std::array<char, 8>, std::array<char, 9>,
+            std::array<char, 10>, std::array<char, 11>, std::array<char, 12>, std::array<char, 13>, std::array<char, 14>,
+            std::array<char, 15>, std::array<char, 16>, std::array<char, 17>, std::array<char, 18>, std::array<char, 19>,
+            std::array<char, 20>, std::array<char, 21>, std::array<char, 22>, std::array<char, 23>, std::array<char, 24>,
+            std::array<char, 25>, std::array<char, 26>, std::array<char, 27>, std::array<char, 28>, std::array<char, 29>,
+            std::array<char, 30>, std::array<char, 31>, std::array<char, 32>, std::array<char, 33>, std::array<char, 34>,
+            std::array<char, 35>, std::array<char, 36>, std::array<char, 37>, std::array<char, 38>, std::array<char, 39>,
+            std::array<char, 40>, std::array<char, 41>, std::array<char, 42>, std::array<char, 43>, std::array<char, 44>,
+            std::array<char, 45>, std::array<char, 46>, std::array<char, 47>, std::array<char, 48>, std::array<char, 49>,
+            std::array<char, 50>, std::array<char, 51>, std::array<char, 52>, std::array<char, 53>, std::array<char, 54>,
+            std::array<char, 55>, std::array<char, 56>, std::array<char, 57>, std::array<char, 58>, std::array<char, 59>,
+            std::array<char, 60>, std::array<char, 61>, std::array<char, 62>, std::array<char, 63>, std::array<char, 64>,
+            std::array<char, 65>, std::array<char, 66>);
+        using Mask = type_mask<Wide>;
+        static_assert(Mask::words == 2);
+
+        Mask m = Mask::of<std::array<char, 66>, std::array<char, 3>, std::array<char, 64>>();
+        m.set<std::array<char, 40>>().reset<std::array<char, 64>>();
+        Test::assert_that(m.count() == 3 && (~m).count() == 64 && m.test(66) && !m.test(64));
+
+        std::vector<std::size_t> seen;
+        m.for_each([&]<class T>() { seen.push_back(std::tuple_size_v<T>); });
+        Test::assert_that(seen == std::vector<std::size_t>{3, 40, 66});
+    });
+
+    Test::test("classifier dispatches by bucket", []() {
+        using Fit = classifier<TypeSort<Order::Asc, Size, Large, Small>>;
+        auto name = [](std::size_t len) {
+            return Fit::dispatch(
+                len, []<class K>() -> std::string { return std::is_same_v<typename K::type, Small> ? "small" : "large"; },
+                []() -> std::string { return "overflow"; });
+        };
+        Test::assert_that(name(1) == "small" && name(3) == "large" && name(4) == "overflow");
+    });
+
+    Test::test("filter kernels agree across simd levels", []() {
+        bool ok = true;
+        auto check = [&]<class T, class Cmp>(op_tag<Cmp> op, T pivot) {
+            std::vector<T> keys(1000 + 37);
+            for (std::size_t i = 0; i < keys.size(); ++i)
+                keys[i] = static_cast<T>((i * 2654435761u) % 97) - static_cast<T>(20);
+
+            std::vector<std::uint32_t> expect;
+            for (std::size_t i = 0; i < keys.size(); ++i)
+                if (Cmp{}(keys[i], pivot))
+                    expect.push_back(static_cast<std::uint32_t>(i));
+
+            for (auto level : {simd_level::scalar, simd_level::sse42, simd_level::avx2}) {
+                std::vector<std::uint32_t> rows(keys.size());
+                std::vector<std::uint64_t> bits((keys.size() + 63) / 64, ~std::uint64_t{0});
+                const std::size_t n = filter_indices(op, pivot, std::span{keys}, std::span{rows}, level);
+                const std::size_t m = filter_bitmap(op, pivot, std::span<const T>{keys}, std::span{bits}, level);
+                rows.resize(n);
+                ok = ok && rows == expect && m == expect.size();
+                for (std::size_t i = 0; i < bits.size() * 64; ++i)
+                    ok = ok && ((bits[i / 64] >> (i % 64)) & 1) == (std::find(expect.begin(), expect.end(), i) != expect.end());
+            }
+        };
+        check(ops::lt{}, std::int32_t{7});
+        check(op_type<"<="_ct>{}, std::uint32_t{7});
+        check(ops::gt{}, std::int64_t{-3});
+        check(ops::geq{}, std::uint64_t{50});
+        check(ops::eq{}, 10.0f);
+        check(ops::neq{}, 10.0);
+        check(ops::lt{}, std::int16_t{5}); // scalar at every level
+        Test::assert_that(ok);
+    });
+
+    Test::test("match_dispatch agrees with match_t", []() {
+        enum class Kind : std::uint8_t { login = 1, ping = 5, quote = 200 };
+        // Tells every case type apart (Small and Mid have the same size).
+        auto which = []<class T>() -> int {
+            return std::is_same_v<T, Small> ? 0 : std::is_same_v<T, Mid> ? 1 : std::is_same_v<T, Large> ? 2 : -1;
+        };
+        static_assert(match_strategy_v<case_<Kind::login, Small>, case_<Kind::ping, Mid>, case_<Kind::quote, Large>,
+                                       case_<std::uint8_t{77}, Small>, case_<std::uint8_t{150}, Mid>,
+                                       case_<std::uint8_t{3}, Large>>
+                      == match_strategy::hashed);
+        bool ok = true;
+        for (int k = -300; k <= 300; ++k) {
+            // linear, no default_
+            ok = ok && match_dispatch<case_<1, Small>, case_<7, Large>>(k, which) == (k == 1 ? 0 : k == 7 ? 2 : -1);
+            // dense
+            using D = Size<Large>;
+            const int dense = match_dispatch<case_<-2, Small>, case_<-1, Mid>, case_<0, Large>, case_<1, Small>,
+                                             case_<3, Mid>, default_<D>>(k, [&]<class T>() {
+                return std::is_same_v<T, Small> ? 0 : std::is_same_v<T, Mid> ? 1 : std::is_same_v<T, Large> ? 2 : 3;
+            });
+            ok = ok && dense == (k == -2 || k == 1 ? 0 : k == -1 || k == 3 ? 1 : k == 0 ? 2 : 3);
+            // hashed, enum keys and an unsigned runtime key
+            const auto u     = static_cast<std::uint8_t>(k);
+            const int hashed = match_dispatch<case_<Kind::login, Small>, case_<Kind::ping, Mid>, case_<Kind::quote, Large>,
+                                              case_<std::uint8_t{77}, Small>, case_<std::uint8_t{150}, Mid>,
+                                              case_<std::uint8_t{3}, Large>>(u, which);
+            ok = ok && hashed == (u == 1 || u == 77 ? 0 : u == 5 || u == 150 ? 1 : u == 200 || u == 3 ? 2 : -1);
+        }
+        Test::assert_that(ok);
+    });
+
+    Test::test("typed_queues drain one type at a time", []() {
+        using Q = typed_queues<detail::HTList<Tick, Label>>;
+        static_assert(Q::depth<Tick> == 8 && Q::depth<Label> == typed_queue_depth);
+
+        auto q = std::make_unique<Q>();
+        bool ok = q->ready().none();
+        std::uint32_t next = 0, seen = 0;
+        for (int round = 0; round < 5; ++round) { // wraps the Tick ring
+            for (int i = 0; i < 6; ++i)
+                ok = ok && q->try_push(Tick{next++});
+            ok = ok && q->try_emplace<Label>("r" + std::to_string(round));
+            ok = ok && q->ready() == Q::mask_type::all();
+
+            std::string labels;
+            q->drain([&]<class T>(std::span<T> batch) {
+                for (T& m : batch) {
+                    if constexpr (std::is_same_v<T, Tick>)
+                        ok = ok && m.v == seen++;
+                    else
+                        labels += std::move(m.name);
+                }
+            });
+            ok = ok && labels == "r" + std::to_string(round) && q->ready().none();
+        }
+        for (int i = 0; i < 8; ++i)
+            ok = ok && q->try_push(Tick{0});
+        ok = ok && !q->try_push(Tick{0}) && q->consume<Tick>([](std::span<Tick>) { }, 3) == 3
+             && q->ready().test<Tick>() && q->drain([](auto) { }) == 5;
+
+        // One producer per type, one consumer.
+        constexpr std::uint32_t n = 100000;
+        std::uint64_t ticks = 0, label_chars = 0;
+        std::thread tick_producer([&] {
+            for (std::uint32_t i = 1; i <= n;)
+                q->try_push(Tick{i}) ? void(++i) : std::this_thread::yield();
+        });
+        std::thread label_producer([&] {
+            for (std::uint32_t i = 0; i < n;)
+                q->try_emplace<Label>("x") ? void(++i) : std::this_thread::yield();
+        });
+        for (std::uint64_t got = 0; got < 2 * n;) {
+            const std::size_t k = q->drain([&]<class T>(std::span<T> batch) {
+                for (const T& m : batch) {
+                    if constexpr (std::is_same_v<T, Tick>)
+                        ticks += m.v;
+                    else
+                        label_chars += m.name.size();
+                }
+            });
+            if (k == 0)
+                std::this_thread::yield();
+            got += k;
+        }
+        tick_producer.join();
+        label_producer.join();
+        Test::assert_that(ok && ticks == std::uint64_t{n} * (n + 1) / 2 && label_chars == n && q->ready().none());
+    });
+
+    Test::test("batch_dispatch groups by alternative", []() {
+        using Event = std::variant<int, std::string, double>;
+        const std::vector<Event> in{1, std::string("a"), 2.5, 2, std::string("b"), 3, 0.5};
+
+        std::vector<std::uint32_t> order(in.size());
+        std::string seen;
+        const auto counts = batch_dispatch(std::span<const Event>{in}, [&](const auto& m) {
+            using T = std::remove_cvref_t<decltype(m)>;
+            if constexpr (std::is_same_v<T, int>)
+                seen += std::to_string(m);
+            else if constexpr (std::is_same_v<T, std::string>)
+                seen += m;
+            else
+                seen += m < 1 ? 'l' : 'h';
+        }, std::span{order});
+        bool ok = seen == "123abhl" && counts == std::array<std::size_t, 3>{3, 2, 2}
+                  && order == std::vector<std::uint32_t>{0, 3, 5, 1, 4, 2, 6};
+
+        std::vector<Event> moved = in;
+        std::size_t ints = 0;
+        std::string text;
+        batch_dispatch_in_place(std::span{moved}, [&](auto& m) {
+            using T = std::remove_cvref_t<decltype(m)>;
+            if constexpr (std::is_same_v<T, int>)
+                ints += static_cast<std::size_t>(m);
+            else if constexpr (std::is_same_v<T, std::string>)
+                text += std::move(m);
+        });
+        for (std::size_t i = 0; i < moved.size(); ++i)
+            ok = ok && moved[i].index() == (i < 3 ? 0u : i < 5 ? 1u : 2u);
+        std::sort(text.begin(), text.end());
+        Test::assert_that(ok && ints == 6 && text == "ab");
+    });
+
+    Test::test("log_ring renders records on drain", []() {
+        enum class Side : char { buy = 'B', sell = 'S' };
+        auto ring = std::make_unique<log_ring<128>>();
+        std::vector<std::string> lines;
+        const auto collect = [&](std::string_view line) { lines.emplace_back(line); };
+
+        bool ok = ring->log<"fill px={} qty={} side={}"_ct>(101.25, 7u, Side::sell) && ring->log<"{{tick}}"_ct>();
+        ok = ok && ring->drain(collect) == 2 && ring->empty();
+        ok = ok && lines == std::vector<std::string>{"fill px=101.25 qty=7 side=S", "{tick}"};
+
+        // 24-byte records in a 128-byte ring: fills, then wraps with padding.
+        lines.clear();
+        std::int64_t next = 0, logged = 0;
+        for (int round = 0; round < 10; ++round) {
+            while (ring->log<"seq {} ok {}"_ct>(next, true))
+                ++next;
+            logged += ring->drain(collect);
+        }
+        for (std::int64_t i = 0; i < next && ok; ++i)
+            ok = lines[static_cast<std::size_t>(i)] == "seq " + std::to_string(i) + " ok true";
+        Test::assert_that(ok && logged == next && next >= 40);
+
+        // A half-ring record fits an empty ring at any cursor position, wrap padding included.
+        auto small = std::make_unique<log_ring<64>>();
+        for (int shift = 0; shift < 8 && ok; ++shift) {
+            for (int i = 0; i < shift; ++i)
+                ok = ok && small->log<"tick"_ct>();
+            small->drain([](std::string_view) { });
+            lines.clear();
+            const std::uint64_t a = 1, b = 2, c = 3;
+            ok = ok && small->log<"{} {} {}"_ct>(a, b, c) && small->drain(collect) == 1 && lines[0] == "1 2 3";
+        }
+        Test::assert_that(ok && small->empty());
+    });
+
+    Test::test("section_registry finds handlers placed by the linker", []() {
+        const auto all = test_handlers.entries();
+        // Three entries from this object, two from tests/registry.cpp.
+        bool ok = all.size() == 5 && std::is_sorted(all.begin(), all.end(), [](const auto& a, const auto& b) {
+                      return a.id < b.id;
+                  });
+        ok = ok && test_handlers.find<Fill>().size() == 3 && test_handlers.find<Cancel>().size() == 2
+             && test_handlers.find<Cancel>()[0].size == sizeof(Cancel) && test_handlers.find<Unhandled>().empty();
+        ok = ok && test_handlers.dispatch(Fill{5}) == 3 && test_handlers.dispatch(Cancel{42}) == 2
+             && test_handlers.dispatch(Unhandled{}) == 0;
+        Test::assert_that(ok && filled == 5 && audited == 1 && cancelled == 42 && registry_tu_calls == 2);
+    });
+
+    Test::test("column_file maps columns written to disk", []() {
+        using Ticks = column_file<detail::HTList<std::uint64_t, double, char>>;
+        // A fresh name per run, so concurrent test runs do not share the file.
+        std::string path = std::string(std::getenv("TMPDIR") ? std::getenv("TMPDIR") : "/tmp") + "/ctql_ticks_XXXXXX";
+        const int fd     = ::mkstemp(path.data());
+        Test::assert_that(fd >= 0);
+        ::close(fd);
+
+        std::vector<std::uint64_t> ts(100);
+        std::vector<double> px(100);
+        std::vector<char> side(100);
+        for (std::size_t i = 0; i < ts.size(); ++i) {
+            ts[i]   = 1000 + i;
+            px[i]   = 0.5 * static_cast<double>(i);
+            side[i] = i % 3 == 0 ? 'S' : 'B';
+        }
+        bool ok = Ticks::write(path.c_str(), std::span<const std::uint64_t>{ts}, std::span<const double>{px},
+                               std::span<const char>{side})
+                  == column_file_error::none;
+
+        Ticks snap;
+        ok = ok && snap.open(path.c_str()) == column_file_error::none && snap.rows() == 100;
+        const auto p = snap.column<double>();
+        ok = ok && std::equal(p.begin(), p.end(), px.begin(), px.end())
+             && std::ranges::equal(snap.column<0>(), ts) && std::ranges::equal(snap.column<char>(), side);
+        ok = ok && reinterpret_cast<std::uintptr_t>(p.data()) % 64 == 0
+             && reinterpret_cast<std::uintptr_t>(snap.column<char>().data()) % 64 == 0;
+
+        Ticks moved = std::move(snap);
+        ok = ok && !snap.is_open() && moved.column<double>().data() == p.data();
+
+        // Rewriting replaces the file: the live mapping keeps the old rows.
+        const std::vector<std::uint64_t> ts2(10, 7);
+        const std::vector<double> px2(10, 9.5);
+        const std::vector<char> side2(10, 'S');
+        ok = ok && Ticks::write(path.c_str(), std::span{ts2}, std::span{px2}, std::span{side2}) == column_file_error::none;
+        ok = ok && moved.rows() == 100 && std::ranges::equal(moved.column<double>(), px);
+        Ticks fresh;
+        ok = ok && fresh.open(path.c_str()) == column_file_error::none && std::ranges::equal(fresh.column<double>(), px2);
+
+        using Other = column_file<detail::HTList<std::uint64_t, char, double>>;
+        Other other;
+        ok = ok && other.open(path.c_str()) == column_file_error::schema_mismatch && !other.is_open();
+        ok = ok && Ticks::write(path.c_str(), std::span<const std::uint64_t>{ts}, std::span<const double>{},
+                                std::span<const char>{side})
+                       == column_file_error::ragged_columns;
+        ok = ok && snap.open((path + ".missing").c_str()) == column_file_error::open_failed;
+        std::remove(path.c_str());
+        Test::assert_that(ok);
+    });
+
+    return Test::conclude() ? 0 : 1;
 }
\ No newline at end of file
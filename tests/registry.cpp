@@ -0,0 +1,13 @@
+// Registers into test_handlers from its own object file: the entries below only
+// reach the registry through the linker's section bounds.
+#include <tests/registry.hpp>
+
+std::uint64_t registry_tu_calls = 0;
+
+namespace {
+    void count_cancel(const Cancel&) { ++registry_tu_calls; }
+    void count_fill(const Fill&) { ++registry_tu_calls; }
+} // namespace
+
+CTQL_REGISTER_HANDLER(test_handlers, Cancel, count_cancel);
+CTQL_REGISTER_HANDLER(test_handlers, Fill, count_fill);
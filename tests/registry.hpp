@@ -0,0 +1,14 @@
+// Messages and registry shared by the test objects, so that handlers registered in
+// separate translation units end up in one linker-collected registry.
+#pragma once
+
+#include <cstdint>
+#include <include/section_registry.hpp>
+
+struct Fill   { std::uint32_t qty; };
+struct Cancel { std::uint64_t order; };
+
+CTQL_SECTION_REGISTRY(test_handlers);
+
+// Calls to the handlers registered in tests/registry.cpp.
+extern std::uint64_t registry_tu_calls;
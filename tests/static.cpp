@@ -1,5 +1,10 @@
 #define CTQL_ENABLE_DSL
+#include <algorithm>
 #include <ctql.hpp>
+#include <include/column_file.hpp>
+#include <span>
+#include <string>
+#include <string_view>
 
 using namespace ctql;
 
@@ -44,4 +49,301 @@ static_assert($type_eq($filter_by(_N, $op("=="), A, B, C, D, E, F), $type_list(A
 static_assert($type_eq(
     $partition_by(_N, $op("<="), A, B, C, D, E, F),
     $type_list($type_list(A, C), $type_list(B, D, E, F))
-));
\ No newline at end of file
+));
+
+// ---- value lists ----
+using V = value_list<30, 10, 20, 10>;
+
+static_assert(std::is_same_v<V::sort<>, value_list<10, 10, 20, 30>>);
+static_assert(std::is_same_v<V::sort<Order::Desc>, value_list<30, 20, 10, 10>>);
+static_assert(std::is_same_v<V::sort<>::unique<>, value_list<10, 20, 30>>);
+static_assert(std::is_same_v<V::partition<20, op_type<"<"_ct>>::pass, value_list<10, 10>>);
+static_assert(std::is_same_v<V::partition<20, op_type<"<"_ct>>::fail, value_list<30, 20>>);
+static_assert(std::is_same_v<V::filter<10, ops::eq>, value_list<10, 10>>);
+static_assert(V::reduce<std::plus<>>() == 70);
+static_assert(V::to_array() == std::array{30, 10, 20, 10});
+static_assert(value_list<>::len == 0);
+
+// ---- scans ----
+static_assert(exclusive_scan_v<Size, A, B, C> == std::array<std::size_t, 3>{0, 10, 30});
+static_assert(exclusive_scan_v<SizeOf, std::uint32_t, std::uint8_t, std::uint64_t>
+              == std::array<std::size_t, 3>{0, 4, 5});
+static_assert(exclusive_scan_v<Size>.empty());
+
+// ---- selection ----
+static_assert(Min_v<A, B, C> == 5 && Max_v<A, B, C> == 20 && Max_v<SizeConst<1>> == 1);
+static_assert(std::is_same_v<min_by_t<Size, A, B, C, D, E, F>, C>);
+static_assert(std::is_same_v<max_by_t<Size, A, B, C, D, E, F>, E>);
+static_assert(std::is_same_v<max_by_t<Size, A, B, F>, B>); // first of equal keys
+static_assert(std::is_same_v<nth_t<0, Size, A, B, C, D, E, F>, C>);
+static_assert(std::is_same_v<nth_t<3, Size, A, B, C, D, E, F>, B>);
+static_assert(std::is_same_v<nth_t<4, Size, A, B, C, D, E, F>, F>);
+static_assert(std::is_same_v<nth_t<5, Size, A, B, C, D, E, F>, E>);
+static_assert(std::is_same_v<top_k_t<3, Size, A, B, C, D, E, F>, detail::HTList<E, B, F>>);
+static_assert(std::is_same_v<top_k_t<0, Size, A, B>, detail::HTList<>>);
+static_assert(std::is_same_v<top_k_t<1, SizeOf, char, double, int>, detail::HTList<double>>);
+
+namespace selection {
+    template <std::size_t I>
+    struct K {
+        static constexpr std::size_t size = (I * 37) % 11;
+    };
+
+    // Indices 0..39 stably sorted by key, ascending or descending (many ties).
+    template <bool Desc>
+    constexpr auto stable_order = [] {
+        std::array<std::size_t, 40> out{};
+        for (std::size_t i = 0; i < out.size(); ++i) {
+            std::size_t j = i;
+            for (; j > 0 && (Desc ? (out[j - 1] * 37) % 11 < (i * 37) % 11
+                                  : (out[j - 1] * 37) % 11 > (i * 37) % 11);
+                 --j)
+                out[j] = out[j - 1];
+            out[j] = i;
+        }
+        return out;
+    }();
+
+    template <std::size_t... Js, std::size_t... Is>
+    constexpr bool agrees_with_sort(std::index_sequence<Js...>, std::index_sequence<Is...>) {
+        using L = detail::HTList<K<Is>...>;
+        return (std::is_same_v<nth_t<Is, Size, K<Is>...>, detail::type_at_t<stable_order<false>[Is], L>> && ...)
+               && std::is_same_v<top_k_t<sizeof...(Js), Size, K<Is>...>,
+                                 detail::HTList<detail::type_at_t<stable_order<true>[Js], L>...>>;
+    }
+
+    static_assert(agrees_with_sort(std::make_index_sequence<7>{}, std::make_index_sequence<40>{}));
+} // namespace selection
+
+// ---- bin packing ----
+using Packed = bin_pack<30, Size, A, B, C, D, E, F>; // 10, 20, 5, 15, 25, 20
+
+static_assert(Packed::bins == 4);
+static_assert(Packed::fill == std::array<std::size_t, 4>{30, 30, 20, 15});
+static_assert(Packed::waste == std::array<std::size_t, 4>{0, 0, 10, 15});
+static_assert(std::is_same_v<detail::type_at_t<0, Packed::type>, bin<30, $type_list(Size<E>, Size<C>)>>);
+static_assert(std::is_same_v<detail::type_at_t<1, Packed::type>, bin<30, $type_list(Size<B>, Size<A>)>>);
+static_assert(detail::type_at_t<1, Packed::type>::offsets == std::array<std::size_t, 2>{0, 20});
+
+// ---- hot/cold split ----
+struct Px    { double v;       static constexpr std::size_t hotness = 90; };
+struct Qty   { int n;          static constexpr std::size_t hotness = 80; };
+struct Side  { char c;         static constexpr std::size_t hotness = 60; };
+struct Owner { long id;        static constexpr std::size_t hotness = 10; };
+struct Note  { char text[100]; static constexpr std::size_t hotness = 1; };
+
+template <class F>
+struct Hotness {
+    using type = F;
+    $size(F::hotness);
+};
+
+using Entry = hot_cold_split<$type_list(Side, Note, Px, Owner, Qty), Hotness, 50>;
+
+static_assert(std::is_same_v<Entry::hot_fields, $type_list(Px, Qty, Side)>);
+static_assert(std::is_same_v<Entry::cold_fields, $type_list(Owner, Note)>);
+static_assert(sizeof(Entry::hot_type) == 32);
+static_assert(Entry::hot_lines == 1);
+static_assert(sizeof(field_block<align_sorted_t<Side, Px, Qty>>) == 16);
+static_assert(std::is_same_v<align_sorted_t<Side, Note, Qty, Owner>, $type_list(Owner, Qty, Side, Note)>);
+static_assert(std::is_same_v<align_sorted_t<Note, Side, Qty, Owner>, $type_list(Owner, Qty, Note, Side)>);
+
+// ---- sharded state ----
+struct RxPackets  { using value_type = std::uint64_t; static constexpr bool contended = true; };
+struct TxPackets  { using value_type = std::uint64_t; static constexpr bool contended = true; };
+struct Generation { using value_type = std::uint32_t; };
+struct Limit      { using value_type = std::uint64_t; };
+
+using Stats = sharded_state<$type_list(Generation, RxPackets, Limit, TxPackets), 4>;
+
+static_assert(Contended<RxPackets>::size == 1 && Contended<Generation>::size == 0);
+static_assert(sizeof(Stats::shard) == 3 * destructive_interference_size);
+static_assert(alignof(Stats::shard) == destructive_interference_size);
+static_assert(sizeof(sharded_state<$type_list(RxPackets, TxPackets), 2>::shard) == 2 * destructive_interference_size);
+static_assert(sizeof(sharded_state<$type_list(Generation, Limit), 2>::shard) == destructive_interference_size);
+
+// ---- function traits ----
+struct Feed {
+    int on_tick(double) const noexcept;
+    void reset() &&;
+};
+
+inline auto on_quote = [n = 0](const A&, long) mutable { return ++n; };
+
+static_assert(std::is_same_v<function_traits<decltype(on_quote)>::as_c_function, int(const A&, long)>);
+static_assert(std::is_same_v<get_nth_argument_t<decltype(on_quote), 1>, long>);
+static_assert(std::is_same_v<function_traits<decltype(&Feed::on_tick)>::class_type, Feed>);
+static_assert(function_traits<decltype(&Feed::on_tick)>::is_noexcept);
+static_assert(function_traits<decltype(&Feed::reset)>::n_args == 0);
+static_assert(std::is_same_v<function_traits<void (*)(int) noexcept>::as_c_function, void(int)>);
+static_assert(is_function_with_signature<decltype(on_quote), int, const A&, long>);
+
+// ---- inplace function ----
+using Small8 = decltype([p = (void*)nullptr] { return p; });
+using Big24  = decltype([a = 0L, b = 0L, c = 0L] { return a + b + c; });
+
+static_assert(inplace_capacity_v<Small8, Big24> == 24 && inplace_align_v<Small8, Big24> == 8);
+static_assert(sizeof(inplace_function_for<long(), Small8, Big24>) == 32);
+
+// ---- size classes ----
+struct S8  { long a; };
+struct S12 { int a[3]; };
+struct S16 { long a[2]; };
+struct S24 { long a[3]; };
+struct S64 { long a[8]; };
+struct S72 { long a[9]; };
+
+using Pool = size_class_allocator<$type_list(S72, S8, S24, S16, S64, S12), 25>;
+
+static_assert(Pool::classes == 4);
+static_assert(Pool::block_size == std::array<std::size_t, 4>{8, 16, 24, 72});
+static_assert(Pool::class_of<S12> == Pool::class_of<S16> && Pool::class_of<S64> == Pool::class_of<S72>);
+static_assert(Pool::class_of<S8> == 0 && Pool::class_of<S24> == 2);
+static_assert(size_class_allocator<$type_list(S12, S16), 20>::classes == 2);
+
+// ---- type masks ----
+using Mask = type_mask<$type_list(A, B, C, D, E, F)>;
+
+static_assert(Mask::words == 1 && Mask::bit<D> == 3);
+static_assert(Mask::from<$type_list(B, D)>() == Mask::of<D, B>());
+static_assert((Mask::of<A, B>() & Mask::of<B, C>()) == Mask::of<B>());
+static_assert((~Mask::of<A>()).count() == 5 && Mask::all().contains(Mask::of<E, F>()));
+static_assert(!Mask::of<A>().intersects(Mask::of<B, C>()) && Mask{}.none());
+
+static_assert(type_mask<detail::HTList<A, B, C>>::from_data({~std::uint64_t{0}}) == type_mask<detail::HTList<A, B, C>>::all());
+
+// ---- classifier ----
+using Fit = classifier<TypeSort<Order::Asc, Size, A, B, C, D, E, F>>; // 5, 10, 15, 20, 20, 25
+
+static_assert(Fit::bucket(0) == 0 && Fit::bucket(5) == 0 && Fit::bucket(6) == 1);
+static_assert(Fit::bucket(20) == 3 && Fit::bucket(21) == 5 && Fit::bucket(26) == 6);
+
+template <std::size_t... Is>
+auto steps(std::index_sequence<Is...>) -> $type_list(SizeConst<3 * Is + 1>...);
+
+template <std::size_t N>
+constexpr bool matches_lower_bound() {
+    using Steps = classifier<decltype(steps(std::make_index_sequence<N>{}))>;
+    for (std::size_t x = 0; x < 3 * N + 5; ++x) {
+        std::size_t expect = 0;
+        while (expect < N && Steps::bounds[expect] < x)
+            ++expect;
+        if (Steps::bucket(x) != expect)
+            return false;
+    }
+    return Steps::bucket(std::size_t(-1)) == N;
+}
+
+static_assert(classifier<$type_list()>::bucket(7) == 0);
+static_assert(matches_lower_bound<17>() && matches_lower_bound<31>() && matches_lower_bound<32>()
+              && matches_lower_bound<100>());
+
+// ---- runtime match ----
+static_assert(match_strategy_v<case_<1, A>, case_<2, B>, default_<C>> == match_strategy::linear);
+static_assert(match_strategy_v<case_<10, A>, case_<11, B>, case_<13, C>, case_<14, D>, case_<12, E>>
+              == match_strategy::dense);
+static_assert(match_strategy_v<case_<-2, A>, case_<-1, B>, case_<0, C>, case_<1, D>, case_<3, E>>
+              == match_strategy::dense); // the range wraps through zero
+static_assert(match_strategy_v<case_<1, A>, case_<100, B>, case_<1000, C>, case_<-7, D>, case_<0x7fff'ffff, E>>
+              == match_strategy::hashed);
+static_assert(match_dispatch<case_<1, A>, case_<2, B>, default_<C>>(2, []<class T>() { return T::size; }) == 20);
+static_assert(match_dispatch<case_<1, A>, case_<100, B>, case_<1000, C>, case_<-7, D>, case_<0x7fff'ffff, E>,
+                             default_<F>>(-7L, []<class T>() { return std::is_same_v<T, D>; }));
+
+// ---- queries ----
+static_assert(std::is_same_v<query<A, B, C, D, E, F>::list<>, $type_list(A, B, C, D, E, F)>);
+static_assert(std::is_same_v<query<A, B, C, D, E, F>::where<_N, $op(">")>::order_by<Order::Asc>::to<std::tuple>,
+                             std::tuple<D, B, F, E>>); // B and F tie at 20: input order kept
+static_assert(std::is_same_v<query<A, B, C, D, E, F>::where<_N, $op(">")>::where<E, $op("<")>::list<>,
+                             $type_list(B, D, F)>);
+static_assert(std::is_same_v<query<A, B, C, D, E, F>::order_by<Order::Desc>::select<Size>::list<>,
+                             TypeSort<Order::Desc, Size, E, B, F, D, A, C>>);
+static_assert(std::is_same_v<query<>::order_by<>::list<>, $type_list()>);
+
+// ---- string pools ----
+using Names = string_pool<"NewOrder"_ct, "Order"_ct, "Cancel"_ct, "Order"_ct, to_ct_string<42>(), "r"_ct, ""_ct>;
+static_assert(Names::size == 7 && Names::bytes == 19); // "NewOrder\0Cancel\0" "42\0"
+static_assert(Names::index_of<"Order"_ct> == 1 && Names::index_of<"42"_ct> == 4);
+static_assert(Names::table[1].offset == 3 && Names::table[3].offset == 3 && Names::table[5].offset == 7);
+static_assert(Names::get<std::string_view>(2) == "Cancel" && Names::get<std::string_view>(6).empty());
+static_assert(Names::find("Cancel", 6) == 2 && Names::find("Orde", 4) == Names::npos);
+static_assert(Names::find("Order", 5) == 1 && Names::find("42", 2) == 4 && Names::find("", 0) == 6);
+static_assert(std::is_sorted(Names::index.begin(), Names::index.end(),
+                             [](const string_hash& a, const string_hash& b) { return a.hash < b.hash; }));
+static_assert([] {
+    for (std::size_t i = 0; i < Names::size; ++i) // argument 3 repeats argument 1
+        if (Names::find(Names::c_str(i), Names::table[i].length) != (i == 3 ? 1 : i))
+            return false;
+    return true;
+}());
+static_assert(string_pool<>::bytes == 0 && string_pool<>::find("", 0) == string_pool<>::npos);
+
+// ---- format strings ----
+static_assert(format_spec<"px={} qty={}"_ct>::args == 2 && format_spec<"none"_ct>::args == 0);
+static_assert(format_spec<"px={} qty={}"_ct>::literal(0) == "px=" && format_spec<"px={} qty={}"_ct>::literal(1) == " qty="
+              && format_spec<"px={} qty={}"_ct>::literal(2).empty());
+static_assert(format_spec<"{{{}}}"_ct>::args == 1 && format_spec<"{{{}}}"_ct>::literal(0) == "{"
+              && format_spec<"{{{}}}"_ct>::literal(1) == "}");
+
+// ---- flat tuples ----
+static_assert(std::is_same_v<$to_tuple(CTQL_SORT_TYPES(A, B, C), flat_tuple), flat_tuple<C, A, B>>);
+static_assert(std::is_same_v<$to_tuple(CTQL_SORT_TYPES(A, B, C)), std::tuple<C, A, B>>);
+
+using Row = flat_tuple<std::uint32_t, double, char>;
+static_assert(std::is_trivially_copyable_v<Row> && !std::is_trivially_copyable_v<std::tuple<std::uint32_t, double, char>>);
+static_assert(std::is_standard_layout_v<flat_tuple<double>> && std::is_empty_v<flat_tuple<>>);
+static_assert(std::tuple_size_v<Row> == 3 && std::is_same_v<std::tuple_element_t<1, Row>, double>);
+static_assert(get<2>(Row{7u, 1.5, 'B'}) == 'B' && get<double>(Row{7u, 1.5, 'B'}) == 1.5);
+static_assert(Row{7u, 1.5, 'B'} == flat_tuple{7u, 1.5, 'B'} && Row{} == Row{0u, 0.0, '\0'});
+static_assert([] {
+    Row r{7u, 1.5, 'B'};
+    auto& [qty, px, side] = r;
+    px *= 2;
+    get<std::uint32_t>(r) += 1;
+    return qty == 8 && get<1>(r) == 3.0 && side == 'B'
+           && flat_apply([](auto q, auto p, auto s) { return q + p + s; }, r) == 8 + 3.0 + 'B';
+}());
+static_assert([] {
+    int x = 1;
+    flat_tuple<int&, int> refs{x, 2};
+    get<0>(refs) = 5;
+    return x == 5 && std::is_same_v<std::tuple_element_t<0, decltype(refs)>, int&>;
+}());
+
+// ---- stable type ids ----
+static_assert(stable_type_id_v<A> != stable_type_id_v<B> && stable_type_id_v<A> == stable_type_id_v<::A>);
+static_assert(stable_type_id_v<A*> != stable_type_id_v<A> && stable_type_id_v<const A> != stable_type_id_v<A>);
+#if defined(__GNUC__) || defined(__clang__)
+static_assert(stable_type_id_v<int> == 0x2b9fff192bd4c83e); // FNV-1a of "int"
+#endif
+
+// ---- column files ----
+using Ticks = column_file<$type_list(std::uint64_t, double, char)>;
+static_assert(Ticks::row_bytes == 17 && Ticks::header_bytes == 64); // 40-byte header + 3 offsets
+static_assert(Ticks::stride(0) == 0 && Ticks::stride(1) == 64 && Ticks::stride(128) == 128);
+static_assert(Ticks::column_offset(0, 100) == 64 && Ticks::column_offset(1, 100) == 64 + 128 * 8
+              && Ticks::column_offset(2, 100) == 64 + 128 * 16 && Ticks::file_size(100) == 64 + 128 * 17);
+static_assert(Ticks::schema_hash != column_file<$type_list(std::uint64_t, char, double)>::schema_hash);
+
+// ---- byte order of struct fields ----
+struct Pair16 { std::uint16_t hi, lo; };
+static_assert(detail::byte_orderable<std::uint32_t[2], std::endian::big> && detail::byte_orderable<char[4], std::endian::big>);
+static_assert(detail::byte_orderable<Pair16, std::endian::native>);
+static_assert(!detail::byte_orderable<Pair16, std::endian::native == std::endian::big ? std::endian::little : std::endian::big>);
+
+constexpr std::endian foreign = std::endian::native == std::endian::big ? std::endian::little : std::endian::big;
+template <std::endian Wire>
+concept gets_pair = requires(basic_wire_view<Wire, std::uint32_t, Pair16> v, Pair16& out) {
+    v.template get<1>();
+    v.template get<1>(out);
+};
+static_assert(gets_pair<std::endian::native> && !gets_pair<foreign>);
+static_assert(requires(basic_wire_view<foreign, std::uint32_t, Pair16> v) { v.template get<0>(); });
+
+// ---- ct_string conversions ----
+using Hello = decltype("hello"_ct);
+static_assert(std::is_convertible_v<Hello, std::string_view> && std::string_view(Hello("hello")) == "hello");
+static_assert(!std::is_convertible_v<Hello, std::string> && !std::is_convertible_v<Hello, std::span<const char>>);
+constexpr int pick(std::string_view) { return 1; }
+inline int pick(const std::string&) { return 2; }
+static_assert(pick("hello"_ct) == 1);